@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+// CARE headers
+#include "care/host_device_ptr.h"
+#include "care/scan.h"
+
+// Other library headers
+#include <benchmark/benchmark.h>
+
+// Std library headers
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// The scans read a fixed array of ones and write to a separate array, so
+// nothing needs to be reset between iterations of the timed loop
+
+static void benchmark_std_partial_sum(benchmark::State& state) {
+   const int size = state.range(0);
+   std::vector<int> data(size, 1);
+   std::vector<int> result(size);
+
+   for (auto _ : state) {
+      std::partial_sum(data.begin(), data.end(), result.begin());
+      benchmark::DoNotOptimize(result.data());
+   }
+}
+
+static void benchmark_seq_exclusive_scan(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<int> data(size, "data");
+   care::host_device_ptr<int> result(size, "result");
+   std::fill(data.data(), data.data() + size, 1);
+
+   for (auto _ : state) {
+      care::exclusive_scan(RAJA::seq_exec{}, data, result, size, 0, false);
+   }
+
+   result.free();
+   data.free();
+}
+
+static void benchmark_seq_inclusive_scan(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<double> data(size, "data");
+   care::host_device_ptr<double> result(size, "result");
+   std::fill(data.data(), data.data() + size, 1.0);
+
+   for (auto _ : state) {
+      care::inclusive_scan(RAJA::seq_exec{}, data, result, size, false);
+   }
+
+   result.free();
+   data.free();
+}
+
+#if defined(CARE_PARALLEL_DEVICE)
+
+static void benchmark_parallel_exclusive_scan(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<int> data(size, "data");
+   care::host_device_ptr<int> result(size, "result");
+   std::fill(data.data(), data.data() + size, 1);
+
+   for (auto _ : state) {
+      care::exclusive_scan(RAJADeviceExec{}, data, result, size, 0, false);
+   }
+
+   result.free();
+   data.free();
+}
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+// Register the function as a benchmark
+BENCHMARK(benchmark_std_partial_sum)->Range(1 << 10, 1 << 26);
+BENCHMARK(benchmark_seq_exclusive_scan)->Range(1 << 10, 1 << 26);
+BENCHMARK(benchmark_seq_inclusive_scan)->Range(1 << 10, 1 << 26);
+
+#if defined(CARE_PARALLEL_DEVICE)
+BENCHMARK(benchmark_parallel_exclusive_scan)->Range(1 << 10, 1 << 26);
+#endif
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+// CARE headers
+#include "care/algorithm.h"
+#include "care/host_device_ptr.h"
+#include "care/SortedIndex.h"
+
+// Other library headers
+#include <benchmark/benchmark.h>
+
+// Std library headers
+#include <random>
+
+// Number of searches done per benchmark iteration
+static const int numQueries = 1 << 20;
+
+static void fillArrays(care::host_device_ptr<int>& sorted, const int size,
+                       care::host_device_ptr<int>& queries) {
+   std::mt19937 generator(size);
+   std::uniform_int_distribution<int> distribution(0, 2 * size);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size) {
+      sorted[i] = 2 * i;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   int* rawQueries = queries.data();
+
+   for (int i = 0; i < numQueries; ++i) {
+      rawQueries[i] = distribution(generator);
+   }
+}
+
+static void benchmark_BinarySearch(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<int> sorted(size, "sorted");
+   care::host_device_ptr<int> queries(numQueries, "queries");
+   care::host_device_ptr<int> results(numQueries, "results");
+   fillArrays(sorted, size, queries);
+
+   for (auto _ : state) {
+      CARE_STREAM_LOOP(i, 0, numQueries) {
+         results[i] = care::BinarySearch<int>(sorted, 0, size, queries[i]);
+      } CARE_STREAM_LOOP_END
+   }
+
+   state.SetItemsProcessed(state.iterations() * numQueries);
+
+   results.free();
+   queries.free();
+   sorted.free();
+}
+
+static void benchmark_BranchlessBinarySearch(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<int> sorted(size, "sorted");
+   care::host_device_ptr<int> queries(numQueries, "queries");
+   care::host_device_ptr<int> results(numQueries, "results");
+   fillArrays(sorted, size, queries);
+
+   for (auto _ : state) {
+      CARE_STREAM_LOOP(i, 0, numQueries) {
+         results[i] = care::BranchlessBinarySearch<int>(sorted.data(), 0, size, queries[i]);
+      } CARE_STREAM_LOOP_END
+   }
+
+   state.SetItemsProcessed(state.iterations() * numQueries);
+
+   results.free();
+   queries.free();
+   sorted.free();
+}
+
+static void benchmark_SortedIndex(benchmark::State& state) {
+   const int size = state.range(0);
+   care::host_device_ptr<int> sorted(size, "sorted");
+   care::host_device_ptr<int> queries(numQueries, "queries");
+   care::host_device_ptr<int> results(numQueries, "results");
+   fillArrays(sorted, size, queries);
+
+   care::SortedIndex<int> index(sorted, size);
+
+   for (auto _ : state) {
+      CARE_STREAM_LOOP(i, 0, numQueries) {
+         results[i] = index.search(queries[i]);
+      } CARE_STREAM_LOOP_END
+   }
+
+   state.SetItemsProcessed(state.iterations() * numQueries);
+
+   results.free();
+   queries.free();
+   sorted.free();
+}
+
+// Register the function as a benchmark
+BENCHMARK(benchmark_BinarySearch)->RangeMultiplier(10)->Range(1000, 100000000);
+BENCHMARK(benchmark_BranchlessBinarySearch)->RangeMultiplier(10)->Range(1000, 100000000);
+BENCHMARK(benchmark_SortedIndex)->RangeMultiplier(10)->Range(1000, 100000000);
+
+// Run the benchmark
+BENCHMARK_MAIN();
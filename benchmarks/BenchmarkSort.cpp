@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+// CARE headers
+#include "care/algorithm.h"
+#include "care/host_device_ptr.h"
+
+// Other library headers
+#include <benchmark/benchmark.h>
+
+// Std library headers
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static std::vector<int> randomValues(const int size) {
+   std::mt19937 generator(size);
+   std::uniform_int_distribution<int> distribution(0, size);
+   std::vector<int> values(size);
+
+   for (int& value : values) {
+      value = distribution(generator);
+   }
+
+   return values;
+}
+
+static void benchmark_std_sort(benchmark::State& state) {
+   const int size = state.range(0);
+   const std::vector<int> values = randomValues(size);
+   std::vector<int> data(size);
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.begin());
+      state.ResumeTiming();
+
+      std::sort(data.begin(), data.end());
+   }
+}
+
+static void benchmark_seq_sortArray(benchmark::State& state) {
+   const int size = state.range(0);
+   const std::vector<int> values = randomValues(size);
+   care::host_device_ptr<int> data(size, "data");
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.data());
+      state.ResumeTiming();
+
+      care::sortArray(RAJA::seq_exec{}, data, size);
+   }
+
+   data.free();
+}
+
+#if defined(CARE_PARALLEL_DEVICE)
+
+static void benchmark_parallel_sortArray(benchmark::State& state) {
+   const int size = state.range(0);
+   const std::vector<int> values = randomValues(size);
+   care::host_device_ptr<int> data(size, "data");
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.data());
+      state.ResumeTiming();
+
+      care::sortArray(RAJADeviceExec{}, data, size);
+   }
+
+   data.free();
+}
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+// Register the function as a benchmark
+BENCHMARK(benchmark_std_sort)->Range(1 << 10, 1 << 26);
+BENCHMARK(benchmark_seq_sortArray)->Range(1 << 10, 1 << 26);
+
+#if defined(CARE_PARALLEL_DEVICE)
+BENCHMARK(benchmark_parallel_sortArray)->Range(1 << 10, 1 << 26);
+#endif
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+// CARE headers
+#include "care/algorithm.h"
+
+// Other library headers
+#include <benchmark/benchmark.h>
+
+// Std library headers
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Sorts many short arrays back to back, as the inner loops of element
+// kernels do
+static const int numArrays = 1 << 14;
+
+static std::vector<double> randomValues(const int size) {
+   std::mt19937 generator(size);
+   std::uniform_real_distribution<double> distribution(0.0, 1.0);
+   std::vector<double> values(size);
+
+   for (double& value : values) {
+      value = distribution(generator);
+   }
+
+   return values;
+}
+
+template <int N>
+static void benchmark_InsertionSort(benchmark::State& state) {
+   const std::vector<double> values = randomValues(N * numArrays);
+   std::vector<double> data(values.size());
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.begin());
+      state.ResumeTiming();
+
+      for (int k = 0; k < numArrays; ++k) {
+         care::InsertionSort(care::local_ptr<double>(data.data() + k * N), N);
+      }
+
+      benchmark::DoNotOptimize(data.data());
+   }
+}
+
+template <int N>
+static void benchmark_sortLocal_runtime(benchmark::State& state) {
+   const std::vector<double> values = randomValues(N * numArrays);
+   std::vector<double> data(values.size());
+
+   // Keep the compiler from seeing the constant length
+   const int len = (int) state.range(0);
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.begin());
+      state.ResumeTiming();
+
+      for (int k = 0; k < numArrays; ++k) {
+         care::sortLocal(care::local_ptr<double>(data.data() + k * N), len);
+      }
+
+      benchmark::DoNotOptimize(data.data());
+   }
+}
+
+template <int N>
+static void benchmark_sortLocal_compiletime(benchmark::State& state) {
+   const std::vector<double> values = randomValues(N * numArrays);
+   std::vector<double> data(values.size());
+
+   for (auto _ : state) {
+      state.PauseTiming();
+      std::copy(values.begin(), values.end(), data.begin());
+      state.ResumeTiming();
+
+      for (int k = 0; k < numArrays; ++k) {
+         care::sortLocal<N>(care::local_ptr<double>(data.data() + k * N));
+      }
+
+      benchmark::DoNotOptimize(data.data());
+   }
+}
+
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(benchmark_InsertionSort, 4);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_runtime, 4)->Arg(4);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_compiletime, 4);
+
+BENCHMARK_TEMPLATE(benchmark_InsertionSort, 8);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_runtime, 8)->Arg(8);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_compiletime, 8);
+
+BENCHMARK_TEMPLATE(benchmark_InsertionSort, 16);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_runtime, 16)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_compiletime, 16);
+
+BENCHMARK_TEMPLATE(benchmark_InsertionSort, 32);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_runtime, 32)->Arg(32);
+BENCHMARK_TEMPLATE(benchmark_sortLocal_compiletime, 32);
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -13,6 +13,10 @@
 
 #include "care/algorithm_decl.h"
 #include "care/CHAIDataGetter.h"
+#include "care/DefaultMacros.h"
+#include "care/host_algorithm.h"
+#include "care/scan.h"
+#include "care/segmented_reduce.h"
 
 namespace care {
 
@@ -39,28 +43,6 @@ template <typename KeyType, typename ValueType, typename Exec>
 using LocalKeyValueSorter = KeyValueSorter<KeyType, ValueType, Exec> ;
 
 
-#if defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
-
-///////////////////////////////////////////////////////////////////////////
-/// @author Peter Robinson, Alan Dayton
-/// @brief ManagedArray API to cub::DeviceRadixSort::SortPairs
-/// @param[in, out] keys   - The array to sort
-/// @param[in, out] values - The array that is sorted simultaneously
-/// @param[in]      start  - The index to start sorting at
-/// @param[in]      len    - The number of elements to sort
-/// @param[in]      noCopy - Whether or not to copy the result into the
-///                             original arrays or simply replace the
-///                             original arrays. Should be false if only
-///                             sorting part of the arrays or you will
-///                             have bugs!
-/// @return void
-///////////////////////////////////////////////////////////////////////////
-template <typename KeyT, typename ValueT, typename Exec=RAJADeviceExec>
-void sortKeyValueArrays(host_device_ptr<KeyT> & keys,
-                        host_device_ptr<ValueT> & values,
-                        const size_t start, const size_t len,
-                        const bool noCopy=false) ;
-
 ///////////////////////////////////////////////////////////////////////////
 /// @author Benjamin Liu after Alan Dayton
 /// @brief Initializes keys and values by copying elements from the array
@@ -87,6 +69,147 @@ template <typename KeyType, typename ValueType>
 void setKeyValueArraysFromManagedArray(host_device_ptr<KeyType> & keys, host_device_ptr<ValueType> & values,
                                        const size_t len, const host_device_ptr<const ValueType>& arr) ;
 
+///////////////////////////////////////////////////////////////////////////
+/// @brief Finds the runs of equal keys in a key array sorted by key.
+///    Defined here since reduceKeyValuesByKey needs it.
+/// @param[in]  keys   - The sorted key array
+/// @param[in]  len    - The number of keys
+/// @param[out] starts - Allocated to hold the index of the first key of
+///                      each run, followed by len
+/// @return the number of runs (distinct keys)
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename Exec>
+inline int findKeySegments(Exec, const host_device_ptr<const KeyType>& keys,
+                           const size_t len, host_device_ptr<int>& starts)
+{
+   const int length = (int) len;
+
+   // Flag the first key of each run, then scan to number the runs
+   host_device_ptr<int> runs(length+1, "runs");
+
+   CARE_LOOP(Exec{}, i, 0, length+1) {
+      runs[i] = i < length && (i == 0 || keys[i] != keys[i-1]);
+   } CARE_LOOP_END
+
+   care::exclusive_scan(Exec{}, runs, nullptr, length+1, 0, true);
+
+   const int numRuns = runs.pick(length);
+
+   starts.alloc(numRuns+1);
+   starts.namePointer("starts");
+
+   CARE_LOOP(Exec{}, i, 0, length+1) {
+      if (i == length) {
+         starts[numRuns] = length;
+      }
+      else if (runs[i] != runs[i+1]) {
+         starts[runs[i]] = i;
+      }
+   } CARE_LOOP_END
+
+   runs.free();
+
+   return numRuns;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Keeps the first value of each run of equal keys
+/// @param[out] newKeys   - Allocated to hold each distinct key once
+/// @param[out] newValues - Allocated to hold the first value of each key
+/// @param[in]  oldKeys   - Old key array (sorted by key)
+/// @param[in]  oldValues - Old value array
+/// @param[in]  oldLen    - Length of the old key/value arrays
+/// @return Length of new key/value arrays
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType, typename Exec>
+size_t uniqueKeyValuesByKey(Exec,
+                            host_device_ptr<KeyType>& newKeys,
+                            host_device_ptr<ValueType>& newValues,
+                            const host_device_ptr<const KeyType>& oldKeys,
+                            const host_device_ptr<const ValueType>& oldValues,
+                            const size_t oldLen) ;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Combines the values of each run of equal keys with op. The runs
+///    are reduced with care::detail::SegmentedReduce, which balances the
+///    work over OpenMP threads or the device however long the runs are.
+///    Defined here rather than in the implementation header since it is
+///    templated on the operator.
+/// @param[out] newKeys   - Allocated to hold each distinct key once
+/// @param[out] newValues - Allocated to hold the reduced value of each key
+/// @param[in]  oldKeys   - Old key array (sorted by key)
+/// @param[in]  oldValues - Old value array
+/// @param[in]  oldLen    - Length of the old key/value arrays
+/// @param[in]  op        - Binary operator, such as RAJA::operators::plus
+/// @return Length of new key/value arrays
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType, typename Exec, typename ReduceOp>
+inline size_t reduceKeyValuesByKey(Exec,
+                                   host_device_ptr<KeyType>& newKeys,
+                                   host_device_ptr<ValueType>& newValues,
+                                   const host_device_ptr<const KeyType>& oldKeys,
+                                   const host_device_ptr<const ValueType>& oldValues,
+                                   const size_t oldLen,
+                                   ReduceOp)
+{
+   host_device_ptr<int> starts;
+   const int newLen = findKeySegments(Exec{}, oldKeys, oldLen, starts);
+
+   newKeys.alloc(newLen);
+   newKeys.namePointer("newKeys");
+   newValues.alloc(newLen);
+   newValues.namePointer("newValues");
+
+   CARE_LOOP(Exec{}, s, 0, newLen) {
+      newKeys[s] = oldKeys[starts[s]];
+   } CARE_LOOP_END
+
+   // Every run holds at least one value, so the identity is never used
+   care::detail::SegmentedReduce<care::detail::SegmentedBinaryOp<ValueType, ReduceOp>>(
+      Exec{}, oldValues, host_device_ptr<int const>(starts), newLen, newValues, ValueType());
+
+   starts.free();
+
+   return (size_t) newLen;
+}
+
+#if defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
+
+///////////////////////////////////////////////////////////////////////////
+/// @author Peter Robinson, Alan Dayton
+/// @brief ManagedArray API to cub::DeviceRadixSort::SortPairs
+/// @param[in, out] keys   - The array to sort
+/// @param[in, out] values - The array that is sorted simultaneously
+/// @param[in]      start  - The index to start sorting at
+/// @param[in]      len    - The number of elements to sort
+/// @param[in]      noCopy - Whether or not to copy the result into the
+///                             original arrays or simply replace the
+///                             original arrays. Should be false if only
+///                             sorting part of the arrays or you will
+///                             have bugs!
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyT, typename ValueT, typename Exec=RAJADeviceExec>
+void sortKeyValueArrays(host_device_ptr<KeyT> & keys,
+                        host_device_ptr<ValueT> & values,
+                        const size_t start, const size_t len,
+                        const bool noCopy=false) ;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable sorts values by keys without reordering keys. When values
+///    holds the original indices, this leaves the permutation that sorts
+///    keys in values (argsort) and skips writing back the sorted keys.
+/// @param[in]      keys   - The array to sort by (unchanged)
+/// @param[in, out] values - The array that is sorted by keys
+/// @param[in]      start  - The index to start sorting at
+/// @param[in]      len    - The number of elements to sort
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyT, typename ValueT, typename Exec=RAJADeviceExec>
+void argsortKeyValueArrays(const host_device_ptr<const KeyT> & keys,
+                           host_device_ptr<ValueT> & values,
+                           const size_t start, const size_t len) ;
+
 ///////////////////////////////////////////////////////////////////////////
 /// @author Jeff Keasler, Alan Dayton
 /// @brief Eliminates duplicate values
@@ -469,6 +592,40 @@ class KeyValueSorter<KeyType, ValueType, RAJADeviceExec> {
          sortKeyValueArrays(m_values, m_keys, 0, m_len, true);
       }
 
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts the keys of "len" elements starting at "start" by value
+      ///    without reordering the values
+      /// Afterwards key(i) is the key that belonged to the i-th smallest value,
+      ///    so when the keys are the original indices they hold the permutation
+      ///    that sorts the values (argsort). The values are left as they were,
+      ///    so the sorted values are never written back.
+      /// @param[in] start - The index to start at
+      /// @param[in] len   - The number of elements to sort
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort(const size_t start, const size_t len) {
+         argsortKeyValueArrays<ValueType, KeyType, RAJADeviceExec>((host_device_ptr<const ValueType>)m_values,
+                                                                   m_keys, start, len);
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts the keys of the first "len" elements by value without
+      ///    reordering the values
+      /// @param[in] len - The number of elements to sort
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort(const size_t len) {
+         argsort(0, len);
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts all the keys by value without reordering the values
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort() {
+         argsort(m_len);
+      }
+
       ///////////////////////////////////////////////////////////////////////////
       /// @author Jeff Keasler, Alan Dayton
       /// @brief Eliminates duplicate values
@@ -505,6 +662,62 @@ class KeyValueSorter<KeyType, ValueType, RAJADeviceExec> {
          }
       }
 
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Combines the values of equal keys
+      /// First does a stable sort by key. Then the values of each run of
+      ///    equal keys are reduced with op, leaving one key/value pair per
+      ///    distinct key, in ascending key order.
+      /// @param[in] op - Binary operator, such as RAJA::operators::plus<ValueType>
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      template <typename ReduceOp>
+      void reduceByKey(ReduceOp op) {
+         if (m_len > 0) {
+            sortByKey();
+
+            host_device_ptr<KeyType> newKeys;
+            host_device_ptr<ValueType> newValues;
+
+            size_t newSize = reduceKeyValuesByKey(RAJADeviceExec{}, newKeys, newValues,
+                                                  (host_device_ptr<const KeyType>)m_keys,
+                                                  (host_device_ptr<const ValueType>)m_values,
+                                                  m_len, op);
+
+            free();
+
+            m_keys = newKeys;
+            m_values = newValues;
+            m_len = newSize;
+         }
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Eliminates duplicate keys
+      /// First does a stable sort by key. Then only the first value of each
+      ///    run of equal keys is kept, leaving one key/value pair per distinct
+      ///    key, in ascending key order.
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void uniqueByKey() {
+         if (m_len > 0) {
+            sortByKey();
+
+            host_device_ptr<KeyType> newKeys;
+            host_device_ptr<ValueType> newValues;
+
+            size_t newSize = uniqueKeyValuesByKey(RAJADeviceExec{}, newKeys, newValues,
+                                                  (host_device_ptr<const KeyType>)m_keys,
+                                                  (host_device_ptr<const ValueType>)m_values,
+                                                  m_len);
+
+            free();
+
+            m_keys = newKeys;
+            m_values = newValues;
+            m_len = newSize;
+         }
+      }
+
       ///////////////////////////////////////////////////////////////////////////
       /// @author Benjamin Liu
       /// @brief no-op
@@ -619,9 +832,27 @@ inline bool cmpKeys(KeyValueType const & left, KeyValueType const & right)
    return left.key < right.key;
 }
 
+///////////////////////////////////////////////////////////////////////////
+/// @author Jeff Keasler, Alan Dayton
+/// @brief Eliminates duplicate values
+/// First does a stable sort based on the values, which preserves the
+///    ordering in case of a tie. Then duplicates are removed. The final
+///    step is to unsort. Done in place on the host.
+/// @param[in/out] keys   - The key array to eliminate duplicates in
+/// @param[in/out] values - The value array to eliminate duplicates in
+/// @param[in] len - original length of key/value arrays
+/// @return new length of arrays
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType>
+size_t eliminateKeyValueDuplicates(host_device_ptr<KeyType>& keys,
+                                   host_device_ptr<ValueType>& values,
+                                   const size_t len) ;
+
 ///////////////////////////////////////////////////////////////////////////
 /// @author Benjamin Liu after Alan Dayton
 /// @brief Initializes keys and values by copying elements from the array
+/// @deprecated KeyValueSorter no longer stores an array of _kv structs.
+///             Use the overload that takes separate key and value arrays.
 /// @param[out] keyValues - The key value array to set
 /// @param[in] len - The number of elements to allocate space for
 /// @param[in] arr - An array to copy elements from
@@ -633,9 +864,10 @@ void setKeyValueArraysFromArray(host_device_ptr<_kv<KeyType, ValueType>> & keyVa
 
 ///////////////////////////////////////////////////////////////////////////
 /// @author Benjamin Liu after Alan Dayton
-/// @brief Initializes the KeyValueSorter by copying elements from the array
-/// @param[out] keys   - The key array to set to the identity
-/// @param[out] values - The value array to set
+/// @brief Initializes keys and values by copying elements from the array
+/// @deprecated KeyValueSorter no longer stores an array of _kv structs.
+///             Use the overload that takes separate key and value arrays.
+/// @param[out] keyValues - The key value array to set
 /// @param[in] len - The number of elements to allocate space for
 /// @param[in] arr - An array to copy elements from
 /// @return void
@@ -644,11 +876,12 @@ template <typename KeyType, typename ValueType>
 void setKeyValueArraysFromManagedArray(host_device_ptr<_kv<KeyType, ValueType>> & keyValues,
                                        const size_t len, const host_device_ptr<const ValueType>& arr) ;
 
-
 ///////////////////////////////////////////////////////////////////////////
 /// @author Jeff Keasler, Alan Dayton
 /// @brief Eliminates duplicate values
 /// Assumes key value array sorted by values.
+/// @deprecated Forwards to the overload that takes separate key and value
+///             arrays, copying the keys and values out and back.
 /// @param[in/out] keyValues - The key value array to eliminate duplicates in
 /// @param[in/out] len - original length of key value array
 /// @return new length of array
@@ -661,6 +894,7 @@ size_t eliminateKeyValueDuplicates(host_device_ptr<_kv<KeyType, ValueType>> & ke
 /// @brief Initializes the keys
 /// The keys are stored in the managed array of _kv structs. To get the
 /// keys separately, they must be copied into their own array.
+/// @deprecated KeyValueSorter::keys() returns the keys without a copy.
 /// @param[out] keys - The key array
 /// @param[in] keyValues - The key value array
 /// @param[in/out] len - length of key value array
@@ -674,6 +908,7 @@ void initializeKeyArray(host_device_ptr<KeyType>& keys, const host_device_ptr<co
 /// @brief Initializes the values
 /// The values are stored in the managed array of _kv structs. To get the
 ///    values separately, they must be copied into their own array.
+/// @deprecated KeyValueSorter::values() returns the values without a copy.
 /// @param[out] values - The values array
 /// @param[in] keyValues - The key value array
 /// @param[in/out] len - length of key value array
@@ -685,13 +920,11 @@ void initializeValueArray(host_device_ptr<ValueType>& values, const host_device_
 #if !CARE_ENABLE_GPU_SIMULATION_MODE
 ///////////////////////////////////////////////////////////////////////////
 /// Sequential partial specialization of KeyValueSorter
-/// The CPU implementation relies on routines that use the < operator on
-/// a key-value struct.
-/// TODO make a version of this that sorts indices as in:
-/// https://stackoverflow.com/questions/3909272/sorting-two-corresponding-arrays
-/// This has the advantage of having the same underlying data layout for keys
-/// and values as the GPU version of the code, which in many instances removes
-/// the need for copying the keys and values into separate arrays after the sort.
+/// Like the GPU version, keys and values are stored as separate arrays, so
+///    keys() and values() need no copies. Sorting sorts the keys (or values)
+///    together with their original positions and then gathers the other
+///    array through the resulting permutation (see
+///    care::detail::stableSortPairs).
 ///////////////////////////////////////////////////////////////////////////
 template <typename KeyType, typename ValueType>
 class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
@@ -714,9 +947,8 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       explicit KeyValueSorter<KeyType, ValueType, RAJA::seq_exec>(size_t len)
       : m_len(len)
       , m_ownsPointers(true)
-      , m_keys(nullptr)
-      , m_values(nullptr)
-      , m_keyValues(len, "m_keyValues")
+      , m_keys(len, "m_keys")
+      , m_values(len, "m_values")
       {
       }
 
@@ -732,11 +964,10 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       KeyValueSorter<KeyType, ValueType, RAJA::seq_exec>(const size_t len, const ValueType* arr)
       : m_len(len)
       , m_ownsPointers(true)
-      , m_keys(nullptr)
-      , m_values(nullptr)
-      , m_keyValues(len, "m_keyValues")
+      , m_keys(len, "m_keys")
+      , m_values(len, "m_values")
       {
-         setKeyValueArraysFromArray(m_keyValues, len, arr);
+         setKeyValueArraysFromArray(m_keys, m_values, len, arr);
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -751,11 +982,10 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       KeyValueSorter<KeyType, ValueType, RAJA::seq_exec>(const size_t len, const host_device_ptr<const ValueType> & arr)
       : m_len(len)
       , m_ownsPointers(true)
-      , m_keys(nullptr)
-      , m_values(nullptr)
-      , m_keyValues(len, "m_keyValues")
+      , m_keys(len, "m_keys")
+      , m_values(len, "m_values")
       {
-         setKeyValueArraysFromManagedArray(m_keyValues, len, arr);
+         setKeyValueArraysFromManagedArray(m_keys, m_values, len, arr);
       }
 
 #if defined(CARE_ENABLE_IMPLICIT_CONVERSIONS)
@@ -799,7 +1029,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       , m_ownsPointers(false)
       , m_keys(other.m_keys)
       , m_values(other.m_values)
-      , m_keyValues(other.m_keyValues)
       {
       }
 
@@ -832,7 +1061,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
             m_ownsPointers = false;
             m_keys = other.m_keys;
             m_values = other.m_values;
-            m_keyValues = other.m_keyValues;
          }
 
          return *this;
@@ -855,13 +1083,11 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
             m_ownsPointers = other.m_ownsPointers;
             m_keys = other.m_keys;
             m_values = other.m_values;
-            m_keyValues = other.m_keyValues;
 
             other.m_len = 0;
             other.m_ownsPointers = false;
             other.m_keys = nullptr;
             other.m_values = nullptr;
-            other.m_keyValues = nullptr;
          }
 
          return *this;
@@ -875,8 +1101,8 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return the key at the given index
       ///////////////////////////////////////////////////////////////////////////
       CARE_HOST_DEVICE KeyType key(const size_t index) const {
-         local_ptr<_kv<KeyType,ValueType> > local_keyValues = m_keyValues;
-         return local_keyValues[index].key;
+         local_ptr<const KeyType> keys = m_keys;
+         return keys[index];
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -888,8 +1114,8 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
       CARE_HOST_DEVICE void setKey(const size_t index, const KeyType key) const {
-         local_ptr<_kv<KeyType, ValueType> > local_keyValues = m_keyValues;
-         local_keyValues[index].key = key;
+         local_ptr<KeyType> keys = m_keys;
+         keys[index] = key;
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -900,8 +1126,8 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return the value at the given index
       ///////////////////////////////////////////////////////////////////////////
       CARE_HOST_DEVICE ValueType value(const size_t index) const {
-         local_ptr<_kv<KeyType, ValueType> > local_keyValues = m_keyValues;
-         return local_keyValues[index].value;
+         local_ptr<const ValueType> values = m_values;
+         return values[index];
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -913,8 +1139,8 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
       CARE_HOST_DEVICE void setValue(const size_t index, const ValueType value) const {
-         local_ptr<_kv<KeyType, ValueType> > local_keyValues = m_keyValues;
-         local_keyValues[index].value = value;
+         local_ptr<ValueType> values = m_values;
+         values[index] = value;
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -923,7 +1149,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return the keys contained in the KeyValueSorter
       ///////////////////////////////////////////////////////////////////////////
       host_device_ptr<KeyType> & keys() {
-         initializeKeys();
          return m_keys;
       }
 
@@ -933,7 +1158,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return a const copy of the keys contained in the KeyValueSorter
       ///////////////////////////////////////////////////////////////////////////
       const host_device_ptr<KeyType> & keys() const {
-         initializeKeys();
          return m_keys;
       }
 
@@ -943,7 +1167,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return the values contained in the KeyValueSorter
       ///////////////////////////////////////////////////////////////////////////
       host_device_ptr<ValueType> & values() {
-         initializeValues();
          return m_values;
       }
 
@@ -953,7 +1176,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       /// @return a const copy of the values contained in the KeyValueSorter
       ///////////////////////////////////////////////////////////////////////////
       const host_device_ptr<ValueType> & values() const {
-         initializeValues();
          return m_values;
       }
 
@@ -969,17 +1191,20 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       ///////////////////////////////////////////////////////////////////////////
       /// @author Peter Robinson
       /// @brief Sorts "len" elements starting at "start" by value
-      /// Calls std::stable_sort, which uses _kv::operator< to do the comparisons
-      /// @note stable_sort is used for consistency with GPU implementation
+      /// Uses a radix sort for large arrays of integer values, otherwise
+      ///    calls std::stable_sort
+      /// @note a stable sort is used for consistency with GPU implementation
       /// @param[in] start - The index to start at
       /// @param[in] len   - The number of elements to sort
       /// @return void
       /// TODO: add bounds checking
       ///////////////////////////////////////////////////////////////////////////
       void sort(const size_t start, const size_t len) const {
-         CHAIDataGetter<_kv<KeyType, ValueType>, RAJA::seq_exec> getter {};
-         _kv<KeyType, ValueType> * rawData = getter.getRawArrayData(m_keyValues) + start;
-         std::stable_sort(rawData, rawData + len);
+         CHAIDataGetter<KeyType, RAJA::seq_exec> keyGetter {};
+         CHAIDataGetter<ValueType, RAJA::seq_exec> valueGetter {};
+         auto * rawKeys = keyGetter.getRawArrayData(m_keys) + start;
+         auto * rawValues = valueGetter.getRawArrayData(m_values) + start;
+         care::detail::stableSortPairs(rawValues, rawKeys, len, false);
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -1004,18 +1229,21 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       ///////////////////////////////////////////////////////////////////////////
       /// @author Peter Robinson
       /// @brief Sorts "len" elements starting at "start" by key
-      /// Calls std::stable_sort, which uses _kv::cmpKeys to do the comparisons (this
-      ///    is an unsort when the keys stored constitute the original ordering)
-      /// @note stable_sort is used for consistency with GPU implementation
+      /// Uses a radix sort for large arrays of integer keys, otherwise calls
+      ///    std::stable_sort (this is an unsort when the keys stored constitute
+      ///    the original ordering)
+      /// @note a stable sort is used for consistency with GPU implementation
       /// @param[in] start - The index to start at
       /// @param[in] len   - The number of elements to unsort
       /// @return void
       /// TODO: add bounds checking
       ///////////////////////////////////////////////////////////////////////////
       void sortByKey(const size_t start, const size_t len) const {
-         CHAIDataGetter<_kv<KeyType, ValueType>, RAJA::seq_exec> getter {};
-         _kv<KeyType, ValueType> * rawData = getter.getRawArrayData(m_keyValues) + start;
-         std::stable_sort(rawData, rawData + len, cmpKeys<_kv<KeyType,ValueType>>);
+         CHAIDataGetter<KeyType, RAJA::seq_exec> keyGetter {};
+         CHAIDataGetter<ValueType, RAJA::seq_exec> valueGetter {};
+         auto * rawKeys = keyGetter.getRawArrayData(m_keys) + start;
+         auto * rawValues = valueGetter.getRawArrayData(m_values) + start;
+         care::detail::stableSortPairs(rawKeys, rawValues, len, false);
       }
 
       ///////////////////////////////////////////////////////////////////////////
@@ -1069,6 +1297,42 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
          stableSort(m_len);
       }
 
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts the keys of "len" elements starting at "start" by value
+      ///    without reordering the values
+      /// Afterwards key(i) is the key that belonged to the i-th smallest value,
+      ///    so when the keys are the original indices they hold the permutation
+      ///    that sorts the values (argsort). The values are left as they were,
+      ///    so the sorted values are never written back.
+      /// @param[in] start - The index to start at
+      /// @param[in] len   - The number of elements to sort
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort(const size_t start, const size_t len) const {
+         CHAIDataGetter<KeyType, RAJA::seq_exec> keyGetter {};
+         auto * rawKeys = keyGetter.getRawArrayData(m_keys) + start;
+         auto * rawValues = host_ptr<const ValueType>(m_values).cdata() + start;
+         care::detail::stableSortValuesByKeys(rawValues, rawKeys, len, false);
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts the keys of the first "len" elements by value without
+      ///    reordering the values
+      /// @param[in] len - The number of elements to sort
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort(const size_t len) const {
+         argsort(0, len);
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Sorts all the keys by value without reordering the values
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void argsort() const {
+         argsort(m_len);
+      }
+
       ///////////////////////////////////////////////////////////////////////////
       /// @author Jeff Keasler, Alan Dayton
       /// @brief Eliminates duplicate values
@@ -1079,114 +1343,132 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       ///////////////////////////////////////////////////////////////////////////
       void eliminateDuplicates() {
          if (m_len > 1) {
-            m_len = eliminateKeyValueDuplicates(m_keyValues, m_len) ;
+            m_len = eliminateKeyValueDuplicates(m_keys, m_values, m_len) ;
+         }
+      }
 
-            // Free stale arrays
-            if (m_keys) {
-               m_keys.free();
-            }
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Combines the values of equal keys
+      /// First does a stable sort by key. Then the values of each run of
+      ///    equal keys are reduced with op, leaving one key/value pair per
+      ///    distinct key, in ascending key order.
+      /// @param[in] op - Binary operator, such as RAJA::operators::plus<ValueType>
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      template <typename ReduceOp>
+      void reduceByKey(ReduceOp op) {
+         if (m_len > 0) {
+            sortByKey();
 
-            if (m_values) {
-               m_values.free();
-            }
+            host_device_ptr<KeyType> newKeys;
+            host_device_ptr<ValueType> newValues;
+
+            size_t newSize = reduceKeyValuesByKey(RAJA::seq_exec{}, newKeys, newValues,
+                                                  (host_device_ptr<const KeyType>)m_keys,
+                                                  (host_device_ptr<const ValueType>)m_values,
+                                                  m_len, op);
+
+            free();
+
+            m_keys = newKeys;
+            m_values = newValues;
+            m_len = newSize;
          }
       }
 
       ///////////////////////////////////////////////////////////////////////////
-      /// @author Alan Dayton
-      /// @brief Initializes the keys
-      /// The keys are stored in the managed array of _kv structs. To get the
-      /// keys separately, they must be copied into their own array.
+      /// @brief Eliminates duplicate keys
+      /// First does a stable sort by key. Then only the first value of each
+      ///    run of equal keys is kept, leaving one key/value pair per distinct
+      ///    key, in ascending key order.
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
-      void initializeKeys() const {
-         if (!m_keys) {
-            m_keys.alloc(m_len);
-            m_keys.namePointer("m_keys");
-            initializeKeyArray(m_keys, (host_device_ptr<const _kv<KeyType, ValueType> >)m_keyValues, m_len);
+      void uniqueByKey() {
+         if (m_len > 0) {
+            sortByKey();
+
+            host_device_ptr<KeyType> newKeys;
+            host_device_ptr<ValueType> newValues;
+
+            size_t newSize = uniqueKeyValuesByKey(RAJA::seq_exec{}, newKeys, newValues,
+                                                  (host_device_ptr<const KeyType>)m_keys,
+                                                  (host_device_ptr<const ValueType>)m_values,
+                                                  m_len);
+
+            free();
+
+            m_keys = newKeys;
+            m_values = newValues;
+            m_len = newSize;
          }
+      }
 
+      ///////////////////////////////////////////////////////////////////////////
+      /// @author Alan Dayton
+      /// @brief no-op
+      /// The keys are stored in their own array, so they do not need to be
+      ///    initialized separately.
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void initializeKeys() const {
          return;
       }
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Alan Dayton
-      /// @brief Initializes the values
-      /// The values are stored in the managed array of _kv structs. To get the
-      ///    values separately, they must be copied into their own array.
+      /// @brief no-op
+      /// The values are stored in their own array, so they do not need to be
+      ///    initialized separately.
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
       void initializeValues() const {
-         if (!m_values) {
-            m_values.alloc(m_len);
-            m_values.namePointer("m_values");
-            initializeValueArray(m_values, (host_device_ptr<const _kv<KeyType, ValueType> >)m_keyValues, m_len);
-         }
-
          return;
       }
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Benjamin Liu
-      /// @brief whether keys allocated
-      /// The keys are stored in the managed array of _kv structs. To get the
-      /// keys separately, they must be copied into their own array.
-      /// This routine returns whether that copy is allocated.
-      /// @return whether keys are allocated
+      /// The keys are stored in their own array, which is always allocated.
+      /// @return true
       ///////////////////////////////////////////////////////////////////////////
       bool keysAllocated() const {
-         return m_keys != nullptr;
+         return true ;
       }
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Benjamin Liu
-      /// @brief whether values allocated
-      /// The values are stored in the managed array of _kv structs. To get the
-      /// values separately, they must be copied into their own array.
-      /// This routine returns whether that copy is allocated.
-      /// @return whether values are allocated
+      /// The values are stored in their own array, which is always allocated.
+      /// @return true
       ///////////////////////////////////////////////////////////////////////////
       bool valuesAllocated() const {
-         return m_values != nullptr;
+         return true ;
       }
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Benjamin Liu
-      /// @brief Free the keys
-      /// The keys are stored in the managed array of _kv structs. To get the
-      /// keys separately, they must be copied into their own array.
-      /// This routine frees that copy.
+      /// @brief no-op
+      /// The keys are stored in their own array, which is freed with the
+      ///    KeyValueSorter.
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
       void freeKeys() const {
-         if (m_keys) {
-            m_keys.free();
-         }
-
          return;
       }
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Benjamin Liu
-      /// @brief Free the values
-      /// The values are stored in the managed array of _kv structs. To get the
-      /// values separately, they must be copied into their own array.
-      /// This routine frees that copy.
+      /// @brief no-op
+      /// The values are stored in their own array, which is freed with the
+      ///    KeyValueSorter.
       /// @return void
       ///////////////////////////////////////////////////////////////////////////
       void freeValues() const {
-         if (m_values) {
-            m_values.free();
-         }
-
          return;
       }
    private:
       size_t m_len = 0;
       bool m_ownsPointers = false; /// Prevents memory from being freed by lambda captures
-      mutable host_device_ptr<KeyType> m_keys = nullptr;
-      mutable host_device_ptr<ValueType> m_values = nullptr;
-      host_device_ptr<_kv<KeyType, ValueType> > m_keyValues = nullptr;
+      host_device_ptr<KeyType> m_keys = nullptr;
+      host_device_ptr<ValueType> m_values = nullptr;
 
       ///////////////////////////////////////////////////////////////////////////
       /// @author Peter Robinson, Alan Dayton
@@ -1196,10 +1478,6 @@ class KeyValueSorter<KeyType, ValueType, RAJA::seq_exec> {
       ///////////////////////////////////////////////////////////////////////////
       inline void free() {
          if (m_ownsPointers) {
-            if (m_keyValues) {
-               m_keyValues.free();
-            }
-
             if (m_keys) {
                m_keys.free();
             }
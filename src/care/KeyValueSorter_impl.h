@@ -21,6 +21,7 @@
 #include "care/KeyValueSorter_decl.h"
 
 // Other CARE headers
+#include "care/host_algorithm.h"
 #include "care/LoopFuser.h"
 // Other library headers
 #ifdef CARE_GPUCC
@@ -37,9 +38,152 @@
 
 namespace care {
 
-// TODO openMP parallel implementation
+///////////////////////////////////////////////////////////////////////////
+/// @author Benjamin Liu after Alan Dayton
+/// @brief Initializes keys and values by copying elements from the array
+/// @param[out] keys   - The key array to set to the identity
+/// @param[out] values - The value array to set
+/// @param[in] len - The number of elements to allocate space for
+/// @param[in] arr - An array to copy elements from
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType>
+CARE_INLINE void setKeyValueArraysFromArray(host_device_ptr<KeyType> & keys,
+                                            host_device_ptr<ValueType> & values,
+                                            const size_t len, const ValueType* arr)
+{
+   CARE_SEQUENTIAL_LOOP(i, 0, len) {
+      keys[i] = (KeyType)i;
+      values[i] = arr[i];
+   } CARE_SEQUENTIAL_LOOP_END
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @author Benjamin Liu after Alan Dayton
+/// @brief Initializes the KeyValueSorter by copying elements from the array
+/// @param[out] keys   - The key array to set to the identity
+/// @param[out] values - The value array to set
+/// @param[in] len - The number of elements to allocate space for
+/// @param[in] arr - An array to copy elements from
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType>
+CARE_INLINE void setKeyValueArraysFromManagedArray(host_device_ptr<KeyType> & keys,
+                                                   host_device_ptr<ValueType> & values,
+                                                   const size_t len, const host_device_ptr<const ValueType>& arr)
+{
+   FUSIBLE_LOOP_STREAM(i, 0, len) {
+      keys[i] = (KeyType) i;
+      values[i] = arr[i];
+   } FUSIBLE_LOOP_STREAM_END
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Keeps the first value of each run of equal keys
+/// @param[out] newKeys   - Allocated to hold each distinct key once
+/// @param[out] newValues - Allocated to hold the first value of each key
+/// @param[in]  oldKeys   - Old key array (sorted by key)
+/// @param[in]  oldValues - Old value array
+/// @param[in]  oldLen    - Length of the old key/value arrays
+/// @return Length of new key/value arrays
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType, typename Exec>
+CARE_INLINE size_t uniqueKeyValuesByKey(Exec,
+                                        host_device_ptr<KeyType>& newKeys,
+                                        host_device_ptr<ValueType>& newValues,
+                                        const host_device_ptr<const KeyType>& oldKeys,
+                                        const host_device_ptr<const ValueType>& oldValues,
+                                        const size_t oldLen)
+{
+   host_device_ptr<int> starts;
+   const int newLen = findKeySegments(Exec{}, oldKeys, oldLen, starts);
+
+   newKeys.alloc(newLen);
+   newKeys.namePointer("newKeys");
+   newValues.alloc(newLen);
+   newValues.namePointer("newValues");
+
+   CARE_LOOP(Exec{}, s, 0, newLen) {
+      const int first = starts[s];
+      newKeys[s] = oldKeys[first];
+      newValues[s] = oldValues[first];
+   } CARE_LOOP_END
+
+   starts.free();
+
+   return (size_t) newLen;
+}
+
+// The RAJADeviceExec implementation. In OpenMP builds the sorts take the
+// host (non CARE_GPUCC) branches below, which use OpenMP threads, and the
+// remaining loops run on the OpenMP policy. The RAJA::seq_exec helpers
+// further down are sequential on purpose.
 #if defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
 
+#ifdef CARE_GPUCC
+
+///////////////////////////////////////////////////////////////////////////
+/// @author Peter Robinson, Alan Dayton
+/// @brief Calls cub::DeviceRadixSort::SortPairs (or the hipcub equivalent),
+///    allocating and freeing the temporary storage it needs
+/// @param[in]  rawKeyData     - The keys to sort by
+/// @param[out] rawKeyResult   - The sorted keys
+/// @param[in]  rawValueData   - The values sorted along with the keys
+/// @param[out] rawValueResult - The sorted values
+/// @param[in]  len            - The number of elements to sort
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename KeyT, typename ValueT>
+CARE_INLINE void deviceRadixSortPairs(const KeyT * rawKeyData, KeyT * rawKeyResult,
+                                      const ValueT * rawValueData, ValueT * rawValueResult,
+                                      const size_t len)
+{
+   if (len == 0) {
+      return;
+   }
+
+   // Get the temp storage length
+   char * d_temp_storage = nullptr;
+   size_t temp_storage_bytes = 0;
+
+   // When called with a nullptr for temp storage, this returns how much
+   // temp storage should be allocated.
+#if defined(__CUDACC__)
+   cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawKeyData, rawKeyResult,
+                                   rawValueData, rawValueResult,
+                                   len);
+#elif defined(__HIPCC__)
+   hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawKeyData, rawKeyResult,
+                                   rawValueData, rawValueResult,
+                                   len);
+#endif
+
+   // Allocate the temp storage and get raw data to pass to cub
+   host_device_ptr<char> tmpManaged {temp_storage_bytes};
+
+   CHAIDataGetter<char, Exec> charGetter {};
+   d_temp_storage = charGetter.getRawArrayData(tmpManaged);
+
+   // Now sort
+#if defined(__CUDACC__)
+   cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawKeyData, rawKeyResult,
+                                   rawValueData, rawValueResult,
+                                   len);
+#elif defined(__HIPCC__)
+   hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawKeyData, rawKeyResult,
+                                   rawValueData, rawValueResult,
+                                   len);
+#endif
+
+   tmpManaged.free();
+}
+
+#endif // defined(CARE_GPUCC)
+
 ///////////////////////////////////////////////////////////////////////////
 /// @author Peter Robinson, Alan Dayton
 /// @brief ManagedArray API to cub::DeviceRadixSort::SortPairs
@@ -69,7 +213,6 @@ CARE_INLINE void sortKeyValueArrays(host_device_ptr<KeyT> & keys,
       _noCopy = noCopy;
    }
 
-   // TODO openMP parallel implementation
 #ifdef CARE_GPUCC
 
    // Allocate space for the result
@@ -86,49 +229,7 @@ CARE_INLINE void sortKeyValueArrays(host_device_ptr<KeyT> & keys,
    auto * rawKeyResult = keyGetter.getRawArrayData(keyResult);
    auto * rawValueResult = valueGetter.getRawArrayData(valueResult);
 
-
-   // Get the temp storage length
-   char * d_temp_storage = nullptr;
-   size_t temp_storage_bytes = 0;
-
-   // When called with a nullptr for temp storage, this returns how much
-   // temp storage should be allocated.
-   if (len > 0) {
-#if defined(__CUDACC__)
-      cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
-                                      rawKeyData, rawKeyResult,
-                                      rawValueData, rawValueResult,
-                                      len);
-#elif defined(__HIPCC__)
-      hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
-                                      rawKeyData, rawKeyResult,
-                                      rawValueData, rawValueResult,
-                                      len);
-#endif
-   }
-
-   // Allocate the temp storage and get raw data to pass to cub
-   host_device_ptr<char> tmpManaged {temp_storage_bytes};
-
-   CHAIDataGetter<char, Exec> charGetter {};
-   d_temp_storage = charGetter.getRawArrayData(tmpManaged);
-
-   // Now sort
-   if (len > 0) {
-#if defined(__CUDACC__)
-      cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
-                                      rawKeyData, rawKeyResult,
-                                      rawValueData, rawValueResult,
-                                      len);
-#elif defined(__HIPCC__)
-      hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
-                                      rawKeyData, rawKeyResult,
-                                      rawValueData, rawValueResult,
-                                      len);
-#endif
-
-      tmpManaged.free();
-   }
+   deviceRadixSortPairs<Exec>(rawKeyData, rawKeyResult, rawValueData, rawValueResult, len);
 
    // Get the result
    if (_noCopy) {
@@ -154,68 +255,75 @@ CARE_INLINE void sortKeyValueArrays(host_device_ptr<KeyT> & keys,
 
 #else // defined(CARE_GPUCC)
 
-   host_device_ptr<_kv<KeyT,ValueT>> keyValues(len);
-
-   CARE_STREAM_LOOP(i, 0, (int) len) {
-      keyValues[i].key = keys[i+start];
-      keyValues[i].value = values[i+start];
-   } CARE_STREAM_LOOP_END
-
-   // Now sort
-
-   CHAIDataGetter<_kv<KeyT, ValueT>, RAJA::seq_exec> getter {};
-   _kv<KeyT, ValueT> * rawData = getter.getRawArrayData(keyValues);
-   std::stable_sort(rawData, rawData + len, cmpKeys<_kv<KeyT,ValueT>>);
+   // Sort in place (in parallel when OpenMP is available). Integer keys
+   // use a radix sort.
+   CHAIDataGetter<KeyT, RAJA::seq_exec> keyGetter {};
+   CHAIDataGetter<ValueT, RAJA::seq_exec> valueGetter {};
 
-   CARE_STREAM_LOOP(i, 0, (int) len) {
-      keys[i+start] = keyValues[i].key;
-      values[i+start] = keyValues[i].value;
-   } CARE_STREAM_LOOP_END
+   auto * rawKeyData = keyGetter.getRawArrayData(keys) + start;
+   auto * rawValueData = valueGetter.getRawArrayData(values) + start;
 
-   keyValues.free();
+   care::detail::stableSortPairs(rawKeyData, rawValueData, len, true);
 
 #endif // defined(CARE_GPUCC)
 
 }
 
 ///////////////////////////////////////////////////////////////////////////
-/// @author Benjamin Liu after Alan Dayton
-/// @brief Initializes keys and values by copying elements from the array
-/// @param[out] keys   - The key array to set to the identity
-/// @param[out] values - The value array to set
-/// @param[in] len - The number of elements to allocate space for
-/// @param[in] arr - An array to copy elements from
+/// @brief Stable sorts values by keys without reordering keys. When values
+///    holds the original indices, this leaves the permutation that sorts
+///    keys in values (argsort) and skips writing back the sorted keys.
+/// @param[in]      keys   - The array to sort by (unchanged)
+/// @param[in, out] values - The array that is sorted by keys
+/// @param[in]      start  - The index to start sorting at
+/// @param[in]      len    - The number of elements to sort
 /// @return void
 ///////////////////////////////////////////////////////////////////////////
-template <typename KeyType, typename ValueType>
-CARE_INLINE void setKeyValueArraysFromArray(host_device_ptr<KeyType> & keys,
-                                            host_device_ptr<ValueType> & values,
-                                            const size_t len, const ValueType* arr)
+template <typename KeyT, typename ValueT, typename Exec>
+CARE_INLINE void argsortKeyValueArrays(const host_device_ptr<const KeyT> & keys,
+                                       host_device_ptr<ValueT> & values,
+                                       const size_t start, const size_t len)
 {
-   CARE_SEQUENTIAL_LOOP(i, 0, len) {
-      keys[i] = (KeyType)i;
-      values[i] = arr[i];
-   } CARE_SEQUENTIAL_LOOP_END
-}
+#ifdef CARE_GPUCC
+
+   // The sorted keys are required by cub, but are thrown away
+   host_device_ptr<KeyT> keyResult{len};
+   host_device_ptr<ValueT> valueResult{len};
+
+   CHAIDataGetter<ValueT, Exec> valueGetter {};
+   CHAIDataGetter<KeyT, Exec> keyGetter {};
+
+   host_device_ptr<KeyT> mutableKeys = *reinterpret_cast<const host_device_ptr<KeyT> *>(&keys);
+
+   auto * rawKeyData = keyGetter.getRawArrayData(mutableKeys) + start;
+   auto * rawValueData = valueGetter.getRawArrayData(values) + start;
+
+   auto * rawKeyResult = keyGetter.getRawArrayData(keyResult);
+   auto * rawValueResult = valueGetter.getRawArrayData(valueResult);
+
+   deviceRadixSortPairs<Exec>(rawKeyData, rawKeyResult, rawValueData, rawValueResult, len);
+
+   CARE_STREAM_LOOP(i, 0, len) {
+      values[i+start] = valueResult[i];
+   } CARE_STREAM_LOOP_END
+
+   if (len > 0) {
+      keyResult.free();
+      valueResult.free();
+   }
+
+#else // defined(CARE_GPUCC)
+
+   // Only the values are written back
+   const KeyT * rawKeyData = host_ptr<const KeyT>(keys).cdata() + start;
+
+   CHAIDataGetter<ValueT, RAJA::seq_exec> valueGetter {};
+   auto * rawValueData = valueGetter.getRawArrayData(values) + start;
+
+   care::detail::stableSortValuesByKeys(rawKeyData, rawValueData, len, true);
+
+#endif // defined(CARE_GPUCC)
 
-///////////////////////////////////////////////////////////////////////////
-/// @author Benjamin Liu after Alan Dayton
-/// @brief Initializes the KeyValueSorter by copying elements from the array
-/// @param[out] keys   - The key array to set to the identity
-/// @param[out] values - The value array to set
-/// @param[in] len - The number of elements to allocate space for
-/// @param[in] arr - An array to copy elements from
-/// @return void
-///////////////////////////////////////////////////////////////////////////
-template <typename KeyType, typename ValueType>
-CARE_INLINE void setKeyValueArraysFromManagedArray(host_device_ptr<KeyType> & keys,
-                                                   host_device_ptr<ValueType> & values,
-                                                   const size_t len, const host_device_ptr<const ValueType>& arr)
-{
-   FUSIBLE_LOOP_STREAM(i, 0, len) {
-      keys[i] = (KeyType) i;
-      values[i] = arr[i];
-   } FUSIBLE_LOOP_STREAM_END
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -312,7 +420,9 @@ CARE_INLINE void IntersectKeyValueSorters(RAJADeviceExec exec,
       matched[i] = i != smaller && searches[i] > -1;
    } CARE_STREAM_LOOP_END
 
-   care::exclusive_scan(RAJADeviceExec{}, matched, nullptr, smaller+1, 0, true);
+   // the scan writes the number of matches to host visible memory, so it is not picked
+   chai::ManagedArray<int> matchCount(1, CARE_SCANVARLENGTHNAME_SPACE);
+   care::exclusive_scan(RAJADeviceExec{}, matched, nullptr, smaller+1, 0, true, matchCount);
 
    CARE_STREAM_LOOP(i, 0, smaller) {
       if (searches[i] > -1) {
@@ -320,7 +430,8 @@ CARE_INLINE void IntersectKeyValueSorters(RAJADeviceExec exec,
          largerMatches[matched[i]] = largerKeys[searches[i]];
       }
    } CARE_STREAM_LOOP_END
-   numMatches =  matched.pick(smaller);
+   care::getFinalScanCountFromPinned(matchCount, numMatches);
+   matchCount.free();
    searches.free();
    matched.free();
    
@@ -338,9 +449,64 @@ CARE_INLINE void IntersectKeyValueSorters(RAJADeviceExec exec,
 
 #endif // defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
 
+///////////////////////////////////////////////////////////////////////////
+/// @author Jeff Keasler, Alan Dayton
+/// @brief Eliminates duplicate values
+/// First does a stable sort based on the values, which preserves the
+///    ordering in case of a tie. Then duplicates are removed. The final
+///    step is to unsort. Done in place on the host.
+/// @param[in/out] keys   - The key array to eliminate duplicates in
+/// @param[in/out] values - The value array to eliminate duplicates in
+/// @param[in] len - original length of key/value arrays
+/// @return new length of arrays
+///////////////////////////////////////////////////////////////////////////
+template <typename KeyType, typename ValueType>
+CARE_INLINE size_t eliminateKeyValueDuplicates(host_device_ptr<KeyType>& keys,
+                                               host_device_ptr<ValueType>& values,
+                                               const size_t len)
+{
+   size_t newSize = len;
+
+   if (len > 1) {
+      CHAIDataGetter<KeyType, RAJA::seq_exec> keyGetter {};
+      CHAIDataGetter<ValueType, RAJA::seq_exec> valueGetter {};
+
+      auto * rawKeys = keyGetter.getRawArrayData(keys);
+      auto * rawValues = valueGetter.getRawArrayData(values);
+
+      // First do a stable sort by value (preserve the original order
+      // in the case of a tie)
+      care::detail::stableSortPairs(rawValues, rawKeys, len, false);
+
+      // Then keep the first of each run of equal values
+      size_t put = 1;
+
+      for (size_t get = 1; get < len; ++get) {
+         if (rawValues[get] != rawValues[put-1]) {
+            rawKeys[put] = rawKeys[get];
+            rawValues[put] = rawValues[get];
+            ++put;
+         }
+      }
+
+      // Then sort by key to get the original ordering
+      care::detail::stableSortPairs(rawKeys, rawValues, put, false);
+
+      // Reallocate memory
+      keys.realloc(put);
+      values.realloc(put);
+
+      newSize = put;
+   }
+
+   return newSize;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 /// @author Benjamin Liu after Alan Dayton
 /// @brief Initializes keys and values by copying elements from the array
+/// @deprecated KeyValueSorter no longer stores an array of _kv structs.
+///             Use the overload that takes separate key and value arrays.
 /// @param[out] keyValues - The key value array to set
 /// @param[in] len - The number of elements to allocate space for
 /// @param[in] arr - An array to copy elements from
@@ -358,7 +524,9 @@ CARE_INLINE void setKeyValueArraysFromArray(host_device_ptr<_kv<KeyType,ValueTyp
 
 ///////////////////////////////////////////////////////////////////////////
 /// @author Benjamin Liu after Alan Dayton
-/// @brief Initializes the KeyValueSorter by copying elements from the array
+/// @brief Initializes keys and values by copying elements from the array
+/// @deprecated KeyValueSorter no longer stores an array of _kv structs.
+///             Use the overload that takes separate key and value arrays.
 /// @param[out] keyValues - The key value array to set
 /// @param[in] len - The number of elements to allocate space for
 /// @param[in] arr - An array to copy elements from
@@ -377,9 +545,8 @@ CARE_INLINE void setKeyValueArraysFromManagedArray(host_device_ptr<_kv<KeyType,
 ///////////////////////////////////////////////////////////////////////////
 /// @author Jeff Keasler, Alan Dayton
 /// @brief Eliminates duplicate values
-/// First does a stable sort based on the values, which preserves the
-///    ordering in case of a tie. Then duplicates are removed. The final
-///    step is to unsort.
+/// @deprecated Forwards to the overload that takes separate key and value
+///             arrays, copying the keys and values out and back.
 /// @param[in/out] keyValues - The key value array to eliminate duplicates in
 /// @param[in/out] len - original length of key value array/new length of array
 ///////////////////////////////////////////////////////////////////////////
@@ -387,52 +554,24 @@ template <typename KeyType, typename ValueType>
 CARE_INLINE size_t eliminateKeyValueDuplicates(host_device_ptr<_kv<KeyType, ValueType> > & keyValues, const size_t len)
 {
    size_t newSize = len;
-   if (len > 1) {
-      CHAIDataGetter<_kv<KeyType, ValueType>, RAJA::seq_exec> getter {};
-      _kv<KeyType, ValueType> * rawData = getter.getRawArrayData(keyValues);
-
-      // First do a stable sort by value (preserve the original order
-      // in the case of a tie)
-      std::stable_sort(rawData, rawData + len);
-
-      // Then eliminate duplicates
-      size_t lsize = len - 1;  /* adjust search range */
-      size_t put = 0;
-      size_t get = 0;
-
-      while (get < lsize) {
-         if (put != get) {
-            memcpy(&rawData[put], &rawData[get], sizeof(struct _kv<KeyType, ValueType>));
-         }
 
-         if (rawData[get].value == rawData[get+1].value) {
-            ++get;
-            ++put;
-
-            while (get < lsize && rawData[get].value == rawData[get+1].value) {
-               ++get;
-            }
-            ++get;
-         }
-         else {
-            ++get;
-            ++put;
-         }
-      }
-
-      if (rawData[lsize].value != rawData[lsize-1].value) {
-         memmove(&rawData[put++], &rawData[lsize], sizeof(struct _kv<KeyType, ValueType>));
-      }
+   if (len > 1) {
+      host_device_ptr<KeyType> keys(len, "eliminateKeyValueDuplicates keys");
+      host_device_ptr<ValueType> values(len, "eliminateKeyValueDuplicates values");
 
-      lsize = put;
+      initializeKeyArray(keys, (host_device_ptr<const _kv<KeyType, ValueType> >) keyValues, len);
+      initializeValueArray(values, (host_device_ptr<const _kv<KeyType, ValueType> >) keyValues, len);
 
-      // Then sort by key to get the original ordering
-      std::sort(rawData, rawData + lsize, cmpKeys<_kv<KeyType,ValueType>>);
+      newSize = eliminateKeyValueDuplicates(keys, values, len);
 
-      // Reallocate memory
-      keyValues.realloc(lsize);
+      CARE_STREAM_LOOP(i, 0, newSize) {
+         keyValues[i].key = keys[i];
+         keyValues[i].value = values[i];
+      } CARE_STREAM_LOOP_END
 
-      newSize = lsize;
+      keyValues.realloc(newSize);
+      values.free();
+      keys.free();
    }
 
    return newSize;
@@ -443,6 +582,7 @@ CARE_INLINE size_t eliminateKeyValueDuplicates(host_device_ptr<_kv<KeyType, Valu
 /// @brief Initializes the keys
 /// The keys are stored in the managed array of _kv structs. To get the
 /// keys separately, they must be copied into their own array.
+/// @deprecated KeyValueSorter::keys() returns the keys without a copy.
 /// @param[out] keys - The key array
 /// @param[in] keyValues - The key value array
 /// @param[in/out] len - length of key value array
@@ -464,6 +604,7 @@ CARE_INLINE void initializeKeyArray(host_device_ptr<KeyType>& keys,
 /// @brief Initializes the values
 /// The values are stored in the managed array of _kv structs. To get the
 ///    values separately, they must be copied into their own array.
+/// @deprecated KeyValueSorter::values() returns the values without a copy.
 /// @param[out] values - The values array
 /// @param[in] keyValues - The key value array
 /// @param[in/out] len - length of key value array
@@ -480,8 +621,6 @@ CARE_INLINE void initializeValueArray(host_device_ptr<ValueType>& values,
    return;
 }
 
-
-
 #if !CARE_ENABLE_GPU_SIMULATION_MODE
 // This assumes arrays have been sorted and unique. If they are not uniqued the GPU
 // and CPU versions may have different behaviors (the index they match to may be different, 
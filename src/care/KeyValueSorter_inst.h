@@ -25,12 +25,19 @@
 
 namespace care {
 
+   CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromArray(host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE> &, const size_t, const CARE_TEMPLATE_ARRAY_TYPE*);
+   CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromManagedArray(host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE> &, const size_t, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&);
+   CARE_EXTERN template CARE_DLL_API size_t eliminateKeyValueDuplicates(host_device_ptr<CARE_TEMPLATE_KEY_TYPE>&, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE>&, const size_t);
+
+   // Deprecated helpers for arrays of _kv structs
    CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromArray(host_device_ptr<_kv<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE> > &, const size_t, const CARE_TEMPLATE_ARRAY_TYPE*);
    CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromManagedArray(host_device_ptr<_kv<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE> > &, const size_t, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&);
    CARE_EXTERN template CARE_DLL_API size_t eliminateKeyValueDuplicates(host_device_ptr<_kv<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE> > &, const size_t);
    CARE_EXTERN template CARE_DLL_API void initializeKeyArray(host_device_ptr<CARE_TEMPLATE_KEY_TYPE>&, const host_device_ptr<const _kv<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE> >&, const size_t);
    CARE_EXTERN template CARE_DLL_API void initializeValueArray(host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE>&, const host_device_ptr<const _kv<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE> >&, const size_t);
 
+   CARE_EXTERN template CARE_DLL_API size_t uniqueKeyValuesByKey(RAJA::seq_exec, host_device_ptr<CARE_TEMPLATE_KEY_TYPE>&, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_KEY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&, const size_t);
+
 #if !CARE_ENABLE_GPU_SIMULATION_MODE
    CARE_EXTERN template class CARE_DLL_API KeyValueSorter<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE, RAJA::seq_exec>;
 
@@ -39,10 +46,9 @@ namespace care {
 
 #if defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
 
-   CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromArray(host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE> &, const size_t, const CARE_TEMPLATE_ARRAY_TYPE*);
-   CARE_EXTERN template CARE_DLL_API void setKeyValueArraysFromManagedArray(host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE> &, const size_t, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&);
    CARE_EXTERN template CARE_DLL_API size_t eliminateKeyValueDuplicates(host_device_ptr<CARE_TEMPLATE_KEY_TYPE>&, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_KEY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&, const size_t);
    CARE_EXTERN template CARE_DLL_API void sortKeyValueArrays<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE, RAJADeviceExec>(host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE> &, const size_t, const size_t, const bool);
+   CARE_EXTERN template CARE_DLL_API void argsortKeyValueArrays<CARE_TEMPLATE_ARRAY_TYPE, CARE_TEMPLATE_KEY_TYPE, RAJADeviceExec>(const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE> &, host_device_ptr<CARE_TEMPLATE_KEY_TYPE> &, const size_t, const size_t);
 
    CARE_EXTERN template class CARE_DLL_API KeyValueSorter<CARE_TEMPLATE_KEY_TYPE, CARE_TEMPLATE_ARRAY_TYPE, RAJADeviceExec>;
 
@@ -50,6 +56,10 @@ namespace care {
 
 #endif // defined(CARE_PARALLEL_DEVICE) || CARE_ENABLE_GPU_SIMULATION_MODE
 
+#ifdef CARE_PARALLEL_DEVICE
+   CARE_EXTERN template CARE_DLL_API size_t uniqueKeyValuesByKey(RAJADeviceExec, host_device_ptr<CARE_TEMPLATE_KEY_TYPE>&, host_device_ptr<CARE_TEMPLATE_ARRAY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_KEY_TYPE>&, const host_device_ptr<const CARE_TEMPLATE_ARRAY_TYPE>&, const size_t);
+#endif // defined(CARE_PARALLEL_DEVICE)
+
 } // namespace care
 
 #undef CARE_TEMPLATE_ARRAY_TYPE
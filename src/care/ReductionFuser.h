@@ -0,0 +1,329 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CARE_REDUCTION_FUSER_H
+#define CARE_REDUCTION_FUSER_H
+
+#include "care/algorithm.h"
+#include "care/CHAIDataGetter.h"
+#include "care/DefaultMacros.h"
+#include "care/host_device_ptr.h"
+#include "care/host_ptr.h"
+
+// Std library headers
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace care {
+   ///////////////////////////////////////////////////////////////////////////
+   /// The reductions supported by ReductionFuser
+   ///////////////////////////////////////////////////////////////////////////
+   enum class reduction_op { sum, min, max };
+
+   namespace detail {
+      ///
+      /// combines two values with the given reduction
+      ///
+      template <typename T>
+      CARE_HOST_DEVICE inline T fusedReduce(const reduction_op op, const T left, const T right) {
+         return op == reduction_op::sum ? left + right :
+                op == reduction_op::min ? care::min(left, right) : care::max(left, right);
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Host version of the chunk reductions of ReductionFuser. Each
+      ///        loop iteration reduces one chunk to partials[c].
+      ///////////////////////////////////////////////////////////////////////////
+      template <typename T, typename Exec>
+      inline void fusedReduceChunks(Exec, host_device_ptr<const T *> pointers,
+                                    host_device_ptr<const int> lengths,
+                                    host_device_ptr<const reduction_op> ops,
+                                    host_device_ptr<const int> chunkArrays,
+                                    host_device_ptr<const int> chunkBegins,
+                                    const int numChunks, const int chunkSize,
+                                    host_device_ptr<T> partials) {
+         CARE_LOOP(Exec{}, c, 0, numChunks) {
+            const int a = chunkArrays[c];
+            const T * data = pointers[a];
+            const int begin = chunkBegins[c];
+            const int end = care::min(begin + chunkSize, lengths[a]);
+            const reduction_op op = ops[a];
+
+            T result = data[begin];
+
+            for (int i = begin + 1; i < end; ++i) {
+               result = fusedReduce(op, result, data[i]);
+            }
+
+            partials[c] = result;
+         } CARE_LOOP_END
+      }
+
+#if defined(CARE_GPUCC)
+
+      ///
+      /// the number of threads that reduce each chunk on the device
+      ///
+      constexpr int reductionFuserBlockSize = 256;
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Each block reduces one chunk. The threads read the chunk
+      ///        with a stride of the block size, so neighboring threads read
+      ///        neighboring elements, and then the per thread results are
+      ///        combined with a tree in shared memory.
+      ///////////////////////////////////////////////////////////////////////////
+      template <typename T>
+      CARE_GLOBAL void reductionFuserKernel(const T * const * pointers, const int * lengths,
+                                            const reduction_op * ops, const int * chunkArrays,
+                                            const int * chunkBegins, const int chunkSize,
+                                            T * partials) {
+         __shared__ T threadResults[reductionFuserBlockSize];
+
+         const int c = blockIdx.x;
+         const int a = chunkArrays[c];
+         const T * data = pointers[a];
+         const int begin = chunkBegins[c];
+         const int end = care::min(begin + chunkSize, lengths[a]);
+         const reduction_op op = ops[a];
+
+         // Every thread starts from an element that is in the chunk. For
+         // a sum only the first thread counts it.
+         T result = op == reduction_op::sum && threadIdx.x != 0 ? (T) 0 : data[begin];
+
+         for (int i = begin + threadIdx.x; i < end; i += blockDim.x) {
+            if (i != begin) {
+               result = fusedReduce(op, result, data[i]);
+            }
+         }
+
+         threadResults[threadIdx.x] = result;
+         __syncthreads();
+
+         for (int stride = blockDim.x / 2; stride > 0; stride /= 2) {
+            if (threadIdx.x < stride) {
+               threadResults[threadIdx.x] = fusedReduce(op, threadResults[threadIdx.x],
+                                                        threadResults[threadIdx.x + stride]);
+            }
+
+            __syncthreads();
+         }
+
+         if (threadIdx.x == 0) {
+            partials[c] = threadResults[0];
+         }
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief GPU version of the chunk reductions of ReductionFuser, with
+      ///        one block per chunk (see reductionFuserKernel)
+      ///////////////////////////////////////////////////////////////////////////
+      template <typename T>
+      inline void fusedReduceChunks(RAJADeviceExec, host_device_ptr<const T *> pointers,
+                                    host_device_ptr<const int> lengths,
+                                    host_device_ptr<const reduction_op> ops,
+                                    host_device_ptr<const int> chunkArrays,
+                                    host_device_ptr<const int> chunkBegins,
+                                    const int numChunks, const int chunkSize,
+                                    host_device_ptr<T> partials) {
+         CHAIDataGetter<const T *, RAJADeviceExec> pointersGetter {};
+         CHAIDataGetter<const int, RAJADeviceExec> intGetter {};
+         CHAIDataGetter<const reduction_op, RAJADeviceExec> opsGetter {};
+         CHAIDataGetter<T, RAJADeviceExec> partialsGetter {};
+
+         reductionFuserKernel<<<numChunks, reductionFuserBlockSize>>>(
+            pointersGetter.getRawArrayData(pointers), intGetter.getRawArrayData(lengths),
+            opsGetter.getRawArrayData(ops), intGetter.getRawArrayData(chunkArrays),
+            intGetter.getRawArrayData(chunkBegins), chunkSize, partialsGetter.getRawArrayData(partials));
+
+#if FORCE_SYNC
+         care::gpuDeviceSynchronize(__FILE__, __LINE__);
+#endif
+      }
+
+#endif // defined(CARE_GPUCC)
+   } // namespace detail
+
+   ///////////////////////////////////////////////////////////////////////////
+   /// @class ReductionFuser
+   /// @brief Batches many small reductions (each over its own array) into a
+   ///        single loop. Every registered array is cut into fixed size
+   ///        chunks, each chunk is reduced to a partial result, and the
+   ///        partial results are combined on the host. On the host one loop
+   ///        iteration reduces one chunk, and on the device one block of
+   ///        threads reduces one chunk with strided reads (see
+   ///        detail::reductionFuserKernel). This replaces one kernel launch
+   ///        (or OpenMP parallel region) and one reducer per array with a
+   ///        single launch for the whole batch, and long arrays do not
+   ///        serialize the loop since they are spread over many chunks.
+   ///        Exec selects where the loop runs (RAJA::seq_exec, OpenMP, or
+   ///        the device).
+   ///////////////////////////////////////////////////////////////////////////
+   template <typename T, typename Exec=RAJAExec>
+   class ReductionFuser {
+
+   public:
+      ReductionFuser() = default;
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief the default destructor
+      ///////////////////////////////////////////////////////////////////////////
+      ~ReductionFuser() = default;
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief resets the Fuser to be prepared for a new set of arrays.
+      ///        Called automatically at the end of reduce().
+      ///////////////////////////////////////////////////////////////////////////
+      void reset();
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief adds an array to be reduced after a later call to reduce()
+      /// @param[in] array - the array to reduce
+      /// @param[in] len - the number of elements to reduce
+      /// @param[in] op - the reduction to perform
+      /// @return the index in the results of reduce() that will hold the
+      ///         result for this array
+      ///////////////////////////////////////////////////////////////////////////
+      int fusibleReduceArray(host_device_ptr<const T> array, int len, reduction_op op);
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief the number of arrays registered since the last reset
+      ///////////////////////////////////////////////////////////////////////////
+      int size() const { return (int) m_arrays.size(); }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief reduces all arrays registered via fusibleReduceArray in a
+      ///        single loop, then resets the Fuser.
+      /// @param[out] results - host array with room for size() values. The
+      ///        result for an empty array is the identity of its reduction
+      ///        (0, the largest T, or the lowest T).
+      ///////////////////////////////////////////////////////////////////////////
+      void reduce(T * results);
+
+      ///
+      /// the number of elements in each chunk
+      ///
+      static constexpr int chunkSize = 2048;
+
+   protected:
+      ///
+      /// the identity of the given reduction
+      ///
+      static T identity(reduction_op op);
+
+      ///
+      /// the arrays registered for reduction
+      ///
+      std::vector<host_device_ptr<const T>> m_arrays;
+      ///
+      /// the lengths of the arrays
+      ///
+      std::vector<int> m_lengths;
+      ///
+      /// the reduction to perform on each array
+      ///
+      std::vector<reduction_op> m_ops;
+   };
+
+   template <typename T, typename Exec>
+   void ReductionFuser<T, Exec>::reset() {
+      m_arrays.resize(0);
+      m_lengths.resize(0);
+      m_ops.resize(0);
+   }
+
+   template <typename T, typename Exec>
+   int ReductionFuser<T, Exec>::fusibleReduceArray(host_device_ptr<const T> array, int len, reduction_op op) {
+      m_arrays.push_back(array);
+      m_lengths.push_back(len > 0 ? len : 0);
+      m_ops.push_back(op);
+      return (int) m_arrays.size() - 1;
+   }
+
+   template <typename T, typename Exec>
+   T ReductionFuser<T, Exec>::identity(reduction_op op) {
+      switch (op) {
+         case reduction_op::min:
+            return std::numeric_limits<T>::max();
+         case reduction_op::max:
+            return std::numeric_limits<T>::lowest();
+         default:
+            return (T) 0;
+      }
+   }
+
+   ///
+   /// perform the fused reductions
+   ///
+   template <typename T, typename Exec>
+   void ReductionFuser<T, Exec>::reduce(T * results) {
+      const int numArrays = size();
+
+      // Cut every array into chunks
+      std::vector<int> hostChunkArrays;
+      std::vector<int> hostChunkBegins;
+
+      for (int a = 0; a < numArrays; ++a) {
+         results[a] = identity(m_ops[a]);
+
+         for (int begin = 0; begin < m_lengths[a]; begin += chunkSize) {
+            hostChunkArrays.push_back(a);
+            hostChunkBegins.push_back(begin);
+         }
+      }
+
+      const int numChunks = (int) hostChunkArrays.size();
+
+      if (numChunks == 0) {
+         reset();
+         return;
+      }
+
+      // Gather the raw pointers in the execution space, so the loop
+      // does not need nested host_device_ptrs
+      host_device_ptr<const T *> pointers(numArrays, "ReductionFuser pointers");
+      host_device_ptr<int> lengths(numArrays, "ReductionFuser lengths");
+      host_device_ptr<reduction_op> ops(numArrays, "ReductionFuser ops");
+      host_device_ptr<int> chunkArrays(numChunks, "ReductionFuser chunkArrays");
+      host_device_ptr<int> chunkBegins(numChunks, "ReductionFuser chunkBegins");
+      host_device_ptr<T> partials(numChunks, "ReductionFuser partials");
+
+      CHAIDataGetter<const T, Exec> getter {};
+      const T ** hostPointers = host_ptr<const T *>(pointers).data();
+
+      for (int a = 0; a < numArrays; ++a) {
+         hostPointers[a] = m_lengths[a] > 0 ? getter.getRawArrayData(m_arrays[a]) : nullptr;
+      }
+
+      std::copy(m_lengths.begin(), m_lengths.end(), host_ptr<int>(lengths).data());
+      std::copy(m_ops.begin(), m_ops.end(), host_ptr<reduction_op>(ops).data());
+      std::copy(hostChunkArrays.begin(), hostChunkArrays.end(), host_ptr<int>(chunkArrays).data());
+      std::copy(hostChunkBegins.begin(), hostChunkBegins.end(), host_ptr<int>(chunkBegins).data());
+
+      detail::fusedReduceChunks(Exec{}, pointers, lengths, ops, chunkArrays, chunkBegins,
+                                numChunks, chunkSize, partials);
+
+      // Combine the partial results on the host
+      const T * hostPartials = host_ptr<const T>(partials).cdata();
+
+      for (int c = 0; c < numChunks; ++c) {
+         const int a = hostChunkArrays[c];
+         results[a] = detail::fusedReduce(m_ops[a], results[a], hostPartials[c]);
+      }
+
+      partials.free();
+      chunkBegins.free();
+      chunkArrays.free();
+      ops.free();
+      lengths.free();
+      pointers.free();
+
+      reset();
+   }
+}
+
+#endif // CARE_REDUCTION_FUSER_H
@@ -0,0 +1,245 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_SORTED_INDEX_H_
+#define _CARE_SORTED_INDEX_H_
+
+// CARE config header
+#include "care/config.h"
+
+// CARE headers
+#include "care/DefaultMacros.h"
+#include "care/host_device_ptr.h"
+#include "care/host_ptr.h"
+#include "care/local_ptr.h"
+
+namespace care {
+
+///////////////////////////////////////////////////////////////////////////
+/// @class SortedIndex
+/// @brief A search structure built from a sorted array that answers the
+///    same queries as BinarySearch, but faster for large arrays.
+/// The elements are stored in Eytzinger (breadth first) order: the root of
+///    the implicit search tree is at 1 and the children of node k are at
+///    2k and 2k+1. Every search walks the same root to leaf path shape, so
+///    the top levels of the tree stay in cache, the next nodes can be
+///    prefetched a few levels ahead, and the loop has no data dependent
+///    branches. A second array maps each node back to its index in the
+///    original sorted array so that results match BinarySearch.
+/// Like KeyValueSorter, copies are shallow and do not own the memory, so
+///    a SortedIndex can be captured by CARE loops and searched on the
+///    device.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+class SortedIndex {
+   public:
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Default constructor
+      /// @return an empty SortedIndex
+      ///////////////////////////////////////////////////////////////////////////
+      SortedIndex() {}
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Constructor
+      /// Builds the search tree from the first size elements of sorted. The
+      ///    build is a single O(size) pass over the data on the host.
+      /// @param[in] sorted - An array sorted in ascending order (duplicates allowed)
+      /// @param[in] size   - The number of elements in sorted
+      /// @return a SortedIndex instance
+      ///////////////////////////////////////////////////////////////////////////
+      SortedIndex(const host_device_ptr<const T>& sorted, const int size)
+      : m_size(size > 0 ? size : 0)
+      , m_ownsPointers(true)
+      , m_layout(m_size + 1, "SortedIndex m_layout")
+      , m_rank(m_size + 1, "SortedIndex m_rank")
+      {
+         if (m_size > 0) {
+            const T* source = host_ptr<const T>(sorted).cdata();
+            T* layout = host_ptr<T>(m_layout).data();
+            int* rank = host_ptr<int>(m_rank).data();
+
+            int next = 0;
+            build(source, layout, rank, next, 1);
+         }
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief (Shallow) Copy constructor
+      /// Does a shallow copy and indicates that the copy should NOT free
+      ///    the underlying memory. This must be a shallow copy because it is
+      ///    called upon lambda capture, and upon exiting the scope of a lambda
+      ///    capture, the copy must NOT free the underlying memory.
+      /// @param[in] other - The other SortedIndex to copy from
+      /// @return a SortedIndex instance
+      ///////////////////////////////////////////////////////////////////////////
+      CARE_HOST_DEVICE SortedIndex(const SortedIndex<T>& other)
+      : m_size(other.m_size)
+      , m_ownsPointers(false)
+      , m_layout(other.m_layout)
+      , m_rank(other.m_rank)
+      {
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Move constructor
+      /// @param[in] other - The other SortedIndex to move from
+      /// @return a SortedIndex instance
+      ///////////////////////////////////////////////////////////////////////////
+      SortedIndex(SortedIndex<T>&& other)
+      : m_size(other.m_size)
+      , m_ownsPointers(other.m_ownsPointers)
+      , m_layout(other.m_layout)
+      , m_rank(other.m_rank)
+      {
+         other.m_size = 0;
+         other.m_ownsPointers = false;
+         other.m_layout = nullptr;
+         other.m_rank = nullptr;
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Destructor
+      /// Frees the underlying memory if this is the owner.
+      ///////////////////////////////////////////////////////////////////////////
+      CARE_HOST_DEVICE ~SortedIndex()
+      {
+#ifndef CARE_DEVICE_COMPILE
+         /// Only attempt to free if we are on the CPU
+         free();
+#endif
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Move assignment operator
+      /// @param[in] other - The other SortedIndex to move from
+      /// @return *this
+      ///////////////////////////////////////////////////////////////////////////
+      SortedIndex<T>& operator=(SortedIndex<T>&& other)
+      {
+         if (this != &other) {
+            free();
+
+            m_size = other.m_size;
+            m_ownsPointers = other.m_ownsPointers;
+            m_layout = other.m_layout;
+            m_rank = other.m_rank;
+
+            other.m_size = 0;
+            other.m_ownsPointers = false;
+            other.m_layout = nullptr;
+            other.m_rank = nullptr;
+         }
+
+         return *this;
+      }
+
+      SortedIndex<T>& operator=(const SortedIndex<T>& other) = delete;
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Gets the number of elements in the index
+      /// @return the number of elements
+      ///////////////////////////////////////////////////////////////////////////
+      CARE_HOST_DEVICE int size() const { return m_size; }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Searches for num. Same results as
+      ///    BinarySearch(sorted, 0, size, num, returnUpperBound), except that
+      ///    when there are duplicates of num the first one is always found.
+      /// @note This should only be called from within a RAJA context.
+      /// @param[in] num              - The value to search for
+      /// @param[in] returnUpperBound - If true, return the index of the first
+      ///                               element greater than num
+      /// @return The index in the original sorted array, or -1 if not found
+      ///////////////////////////////////////////////////////////////////////////
+      CARE_HOST_DEVICE int search(const T num, const bool returnUpperBound = false) const
+      {
+         local_ptr<const T> layout = m_layout;
+         local_ptr<const int> rank = m_rank;
+
+         int k = 1;
+
+         while (k <= m_size) {
+#if !defined(CARE_DEVICE_COMPILE) && (defined(__GNUC__) || defined(__clang__))
+            // The descendants a few levels down share a cache line
+            const long ahead = (long) k * s_prefetchStride;
+
+            if (ahead <= m_size) {
+               __builtin_prefetch(&layout[ahead]);
+            }
+#endif
+
+            const bool goRight = returnUpperBound ? !(num < layout[k]) : (layout[k] < num);
+            k = 2 * k + (goRight ? 1 : 0);
+         }
+
+         // Undo the trailing right turns plus the final left turn to get the
+         // node holding the bound. If there is none, k ends up as 0.
+         while (k & 1) {
+            k >>= 1;
+         }
+
+         k >>= 1;
+
+         if (k == 0) {
+            return -1;
+         }
+         else if (returnUpperBound || layout[k] == num) {
+            return rank[k];
+         }
+         else {
+            return -1;
+         }
+      }
+
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Frees the underlying memory if this is the owner
+      /// @return void
+      ///////////////////////////////////////////////////////////////////////////
+      void free()
+      {
+         if (m_ownsPointers) {
+            if (m_layout) {
+               m_layout.free();
+            }
+
+            if (m_rank) {
+               m_rank.free();
+            }
+         }
+
+         m_layout = nullptr;
+         m_rank = nullptr;
+         m_size = 0;
+      }
+
+   private:
+      ///////////////////////////////////////////////////////////////////////////
+      /// @brief Fills the subtree rooted at node k with an in order walk of
+      ///    the sorted source array.
+      ///////////////////////////////////////////////////////////////////////////
+      void build(const T* source, T* layout, int* rank, int& next, const int k) const
+      {
+         if (k <= m_size) {
+            build(source, layout, rank, next, 2 * k);
+            layout[k] = source[next];
+            rank[k] = next++;
+            build(source, layout, rank, next, 2 * k + 1);
+         }
+      }
+
+      static constexpr int s_prefetchStride = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+
+      int m_size = 0;
+      bool m_ownsPointers = false;
+      host_device_ptr<T> m_layout = nullptr;
+      host_device_ptr<int> m_rank = nullptr;
+};
+
+} // namespace care
+
+#endif // !defined(_CARE_SORTED_INDEX_H_)
@@ -16,11 +16,15 @@
 #include "care/host_ptr.h"
 #include "care/local_ptr.h"
 #include "care/policies.h"
+#include "care/sorting_network.h"
 
 #if CARE_HAVE_LLNL_GLOBALID
 #include "LLNL_GlobalID.h"
 #endif // CARE_HAVE_LLNL_GLOBALID
 
+// Std library headers
+#include <vector>
+
 namespace care {
 
 template <typename T>
@@ -180,6 +184,97 @@ T ArrayMaskedSumSubset(care::host_device_ptr<const T> arr, care::host_device_ptr
 template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
 T ArrayMaskedSum(care::host_device_ptr<const T> arr, care::host_device_ptr<int const> mask, int n, T initVal);
 
+///////////////////////////////////////////////////////////////////////////
+/// @brief Summary statistics of an array, as computed by ArrayStats and
+///        its masked / subset variants in a single pass over the data.
+///        If no elements were visited, count is 0, minLoc and maxLoc are
+///        -1, min is the largest and max the lowest value of T, and sum is 0.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename ReduceType=T>
+struct ArrayStatistics {
+   T min;
+   T max;
+   ReduceType sum;
+   int count;
+   int minLoc;
+   int maxLoc;
+};
+
+template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
+ArrayStatistics<T, ReduceType> ArrayStats(care::host_device_ptr<const T> arr, int n);
+
+template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
+ArrayStatistics<T, ReduceType> ArrayStatsSubset(care::host_device_ptr<const T> arr, care::host_device_ptr<int const> subset, int n);
+
+template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
+ArrayStatistics<T, ReduceType> ArrayMaskedStats(care::host_device_ptr<const T> arr, care::host_device_ptr<int const> mask, int n);
+
+template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
+ArrayStatistics<T, ReduceType> ArrayMaskedStatsSubset(care::host_device_ptr<const T> arr, care::host_device_ptr<int const> mask, care::host_device_ptr<int const> subset, int n);
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Segmented reductions over CSR style data. Segment s covers
+///        values[offsets[s]] up to but not including values[offsets[s+1]],
+///        so offsets has numSegments+1 entries and must be nondecreasing.
+///        The result for segment s is written to the s-th entry of the
+///        output array. Empty segments get 0 (SegmentedSum), the largest
+///        value of T (SegmentedMin), the lowest value of T (SegmentedMax)
+///        or -1 (SegmentedArgMin). SegmentedArgMin gives the index into
+///        values of the first minimum of each segment.
+///        The work is split into fixed size tiles of values rather than
+///        one iteration per segment, so very long segments do not leave
+///        the other threads idle.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename ReduceType=T, typename Exec=RAJAExec>
+void SegmentedSum(care::host_device_ptr<const T> values, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<ReduceType> sums);
+
+template <typename T, typename Exec=RAJAExec>
+void SegmentedMin(care::host_device_ptr<const T> values, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<T> mins);
+
+template <typename T, typename Exec=RAJAExec>
+void SegmentedMax(care::host_device_ptr<const T> values, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<T> maxs);
+
+template <typename T, typename Exec=RAJAExec>
+void SegmentedArgMin(care::host_device_ptr<const T> values, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<int> locs);
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Counts the values in each bin. Histogram splits [lo, hi) into
+///        nbins equal bins, and BinCount uses the keys themselves as bins
+///        in [0, nbins). Values or keys outside of the bins are not
+///        counted. counts must have room for nbins entries. If offsets is
+///        given, it must have room for nbins+1 entries and gets the
+///        exclusive scan of counts, ready to feed a bucket sort.
+///        Each thread (or each chunk of values on the device) counts into
+///        private bins that are merged at the end, so few bins do not
+///        cause contention.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Exec=RAJAExec>
+void Histogram(care::host_device_ptr<const T> values, int n, int nbins, T lo, T hi,
+               care::host_device_ptr<int> counts, care::host_device_ptr<int> offsets=nullptr);
+
+template <typename Exec=RAJAExec>
+void BinCount(care::host_device_ptr<const int> keys, int n, int nbins,
+              care::host_device_ptr<int> counts, care::host_device_ptr<int> offsets=nullptr);
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Exclusive and inclusive scans of any trivially copyable type
+///        with any associative operation, such as a max scan, a min that
+///        keeps its index, or a sum of 64 bit sizes. op is a
+///        CARE_HOST_DEVICE function object taking two values of T and
+///        returning their combination, and init is the first value of an
+///        exclusive scan (the identity of op, for the usual scan). out may
+///        be the same array as in. The scans of int, size_t, float and
+///        double with RAJA::operators::plus, minimum and maximum are
+///        instantiated in the library.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Exec=RAJAExec, typename BinaryOp>
+void ExclusiveScan(care::host_device_ptr<const T> in, care::host_device_ptr<T> out, int n,
+                   BinaryOp op, T init);
+
+template <typename T, typename Exec=RAJAExec, typename BinaryOp>
+void InclusiveScan(care::host_device_ptr<const T> in, care::host_device_ptr<T> out, int n,
+                   BinaryOp op);
+
 template <typename T, typename Exec=RAJAExec>
 int FindIndexGT(care::host_device_ptr<const T> arr, int n, T limit);
 
@@ -263,6 +358,27 @@ CARE_HOST_DEVICE int BinarySearch(const care::host_device_ptr<mapType> & map, co
                                   const int mapSize, const mapType num,
                                   bool returnUpperBound = false) ;
 
+template<typename mapType>
+CARE_HOST_DEVICE int BranchlessBinarySearch(const mapType *map, const int start,
+                                            const int mapSize, const mapType num,
+                                            bool returnUpperBound = false) ;
+
+#ifdef CARE_PARALLEL_DEVICE
+template<typename mapType>
+void BinarySearchBatch(RAJADeviceExec exec,
+                       care::host_device_ptr<const mapType> map, const int start, const int mapSize,
+                       care::host_device_ptr<const mapType> queries, const int numQueries,
+                       care::host_device_ptr<int> results,
+                       bool returnUpperBound = false, bool queriesSorted = false) ;
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+template<typename mapType>
+void BinarySearchBatch(RAJA::seq_exec exec,
+                       care::host_device_ptr<const mapType> map, const int start, const int mapSize,
+                       care::host_device_ptr<const mapType> queries, const int numQueries,
+                       care::host_device_ptr<int> results,
+                       bool returnUpperBound = false, bool queriesSorted = false) ;
+
 #ifdef CARE_PARALLEL_DEVICE
 template <typename T>
 void IntersectArrays(RAJADeviceExec exec,
@@ -307,6 +423,90 @@ void IntersectArrays(RAJA::seq_exec exec,
                      care::host_device_ptr<int> &matches1, care::host_device_ptr<int> &matches2,
                      int *numMatches);
 
+///////////////////////////////////////////////////////////////////////////
+/// @brief Set operations on two arrays of unique elements sorted in
+///        ascending order: arr1[start1] to arr1[start1+size1-1] and
+///        arr2[start2] to arr2[start2+size2-1]. result is allocated to hold
+///        the sorted, unique elements of the union, the difference (in arr1
+///        but not arr2) or the symmetric difference (in exactly one of the
+///        arrays), and resultSize is set to its length. result is nullptr if
+///        it would be empty. These run in linear time, split across threads
+///        with a merge path partition.
+///////////////////////////////////////////////////////////////////////////
+#ifdef CARE_PARALLEL_DEVICE
+template <typename T>
+void UnionArrays(RAJADeviceExec exec,
+                 care::host_device_ptr<const T> arr1, int size1, int start1,
+                 care::host_device_ptr<const T> arr2, int size2, int start2,
+                 care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void UnionArrays(RAJADeviceExec exec,
+                 care::host_device_ptr<T> arr1, int size1, int start1,
+                 care::host_device_ptr<T> arr2, int size2, int start2,
+                 care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void DifferenceArrays(RAJADeviceExec exec,
+                      care::host_device_ptr<const T> arr1, int size1, int start1,
+                      care::host_device_ptr<const T> arr2, int size2, int start2,
+                      care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void DifferenceArrays(RAJADeviceExec exec,
+                      care::host_device_ptr<T> arr1, int size1, int start1,
+                      care::host_device_ptr<T> arr2, int size2, int start2,
+                      care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void SymmetricDifferenceArrays(RAJADeviceExec exec,
+                               care::host_device_ptr<const T> arr1, int size1, int start1,
+                               care::host_device_ptr<const T> arr2, int size2, int start2,
+                               care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void SymmetricDifferenceArrays(RAJADeviceExec exec,
+                               care::host_device_ptr<T> arr1, int size1, int start1,
+                               care::host_device_ptr<T> arr2, int size2, int start2,
+                               care::host_device_ptr<T> &result, int *resultSize);
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+template <typename T>
+void UnionArrays(RAJA::seq_exec exec,
+                 care::host_device_ptr<const T> arr1, int size1, int start1,
+                 care::host_device_ptr<const T> arr2, int size2, int start2,
+                 care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void UnionArrays(RAJA::seq_exec exec,
+                 care::host_device_ptr<T> arr1, int size1, int start1,
+                 care::host_device_ptr<T> arr2, int size2, int start2,
+                 care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void DifferenceArrays(RAJA::seq_exec exec,
+                      care::host_device_ptr<const T> arr1, int size1, int start1,
+                      care::host_device_ptr<const T> arr2, int size2, int start2,
+                      care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void DifferenceArrays(RAJA::seq_exec exec,
+                      care::host_device_ptr<T> arr1, int size1, int start1,
+                      care::host_device_ptr<T> arr2, int size2, int start2,
+                      care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void SymmetricDifferenceArrays(RAJA::seq_exec exec,
+                               care::host_device_ptr<const T> arr1, int size1, int start1,
+                               care::host_device_ptr<const T> arr2, int size2, int start2,
+                               care::host_device_ptr<T> &result, int *resultSize);
+
+template <typename T>
+void SymmetricDifferenceArrays(RAJA::seq_exec exec,
+                               care::host_device_ptr<T> arr1, int size1, int start1,
+                               care::host_device_ptr<T> arr2, int size2, int start2,
+                               care::host_device_ptr<T> &result, int *resultSize);
+
 template <typename T, template<class A> class Accessor = care::CARE_DEFAULT_ACCESSOR>
 void sortArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> & Array, size_t len, int start, bool noCopy) ;
 
@@ -328,6 +528,36 @@ void sortArray(RAJADeviceExec, care::host_device_ptr<T, Accessor> &Array, size_t
 
 #endif // defined(CARE_PARALLEL_DEVICE)
 
+///////////////////////////////////////////////////////////////////////////
+/// @brief Selection algorithms for when only the smallest few elements of
+///        an array are needed, which cost close to O(len) instead of the
+///        O(len log len) of sorting the whole array.
+///        NthElement rearranges array so that array[n] is the element that
+///        would be there if array were sorted, with nothing greater before
+///        it and nothing less after it (like std::nth_element).
+///        PartialSort rearranges array so that its first k elements are
+///        its k smallest in sorted order (like std::partial_sort).
+///        TopK leaves array alone and allocates values and indices with
+///        the min(k, len) smallest elements and their positions, ordered
+///        by value, then by position.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+void NthElement(RAJA::seq_exec, care::host_device_ptr<T> array, int len, int n);
+template <typename T>
+void PartialSort(RAJA::seq_exec, care::host_device_ptr<T> array, int len, int k);
+template <typename T>
+void TopK(RAJA::seq_exec, care::host_device_ptr<const T> array, int len, int k,
+          care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices);
+#ifdef CARE_PARALLEL_DEVICE
+template <typename T>
+void NthElement(RAJADeviceExec, care::host_device_ptr<T> array, int len, int n);
+template <typename T>
+void PartialSort(RAJADeviceExec, care::host_device_ptr<T> array, int len, int k);
+template <typename T>
+void TopK(RAJADeviceExec, care::host_device_ptr<const T> array, int len, int k,
+          care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices);
+#endif // defined(CARE_PARALLEL_DEVICE)
+
 // TODO should this have an unused noCopy parameter?
 template <typename T, template<class A> class Accessor = care::CARE_DEFAULT_ACCESSOR>
 void uniqArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> Array, size_t len, care::host_device_ptr<T, Accessor> & outArray, int & newLen);
@@ -343,6 +573,49 @@ int uniqArray(RAJADeviceExec exec, care::host_device_ptr<T, Accessor> & Array, s
 template <typename T, typename Exec>
 void sort_uniq(Exec e, care::host_device_ptr<T> * array, int * len, bool noCopy = false);
 
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sorts every segment of array in ascending order, where segment s
+///        is array[offsets[s]] up to but not including array[offsets[s+1]].
+///        Use these instead of calling sortLocal / uniqLocal per segment
+///        from within a loop. uniqSegments removes duplicates from each
+///        sorted segment, moving the unique values to the front of the
+///        segment, and writes the new length of each segment to lengths.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+void sortSegments(RAJA::seq_exec, care::host_device_ptr<T> array, care::host_device_ptr<int const> offsets, int numSegments);
+template <typename T>
+void uniqSegments(RAJA::seq_exec, care::host_device_ptr<T> array, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<int> lengths);
+#ifdef CARE_PARALLEL_DEVICE
+template <typename T>
+void sortSegments(RAJADeviceExec, care::host_device_ptr<T> array, care::host_device_ptr<int const> offsets, int numSegments);
+template <typename T>
+void uniqSegments(RAJADeviceExec, care::host_device_ptr<T> array, care::host_device_ptr<int const> offsets, int numSegments, care::host_device_ptr<int> lengths);
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Merges sorted runs into result, which is allocated here with
+///        resultLen elements. The runs are either the segments of array
+///        (segment s is array[offsets[s]] up to but not including
+///        array[offsets[s+1]]) or separate arrays with the given lengths.
+///        Equal elements keep the order of their runs. If uniq is true,
+///        duplicates are dropped as the runs are merged. Use these instead
+///        of concatenating sorted chunks and sorting them again.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const T> array, care::host_device_ptr<int const> offsets, int numSegments,
+                 care::host_device_ptr<T> & result, int & resultLen, bool uniq=false);
+template <typename T>
+void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const T>> & arrays, const std::vector<int> & lengths,
+                 care::host_device_ptr<T> & result, int & resultLen, bool uniq=false);
+#ifdef CARE_PARALLEL_DEVICE
+template <typename T>
+void MergeSorted(RAJADeviceExec, care::host_device_ptr<const T> array, care::host_device_ptr<int const> offsets, int numSegments,
+                 care::host_device_ptr<T> & result, int & resultLen, bool uniq=false);
+template <typename T>
+void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const T>> & arrays, const std::vector<int> & lengths,
+                 care::host_device_ptr<T> & result, int & resultLen, bool uniq=false);
+#endif // defined(CARE_PARALLEL_DEVICE)
+
 enum class compress_array { removed_list, mapping_list };
 
 template <typename T>
@@ -391,12 +664,15 @@ CARE_HOST_DEVICE void sortLocal(care::local_ptr<T> array, int len);
  * Function  : sortLocal
  * Author(s) : Benjamin Liu
  * Purpose   : General sort routine to call from within RAJA loops.
- *             Sorts in ascending order.
+ *             Sorts in ascending order. Lengths up to
+ *             care::detail::maxSortingNetworkSize use a sorting network.
  ************************************************************************/
 template <typename T>
 CARE_HOST_DEVICE inline void sortLocal(care::local_ptr<T> array, int len)
 {  
-   if (len > 1) {
+   T * rawArray = array;
+
+   if (len > 1 && !care::detail::sortingNetwork(rawArray, len)) {
 #if defined(__CUDA_ARCH__)
       // TODO this should be replaced with a CUDA GPU sort implementation that
       // is reasonable for longer arrays.
@@ -412,6 +688,19 @@ CARE_HOST_DEVICE inline void sortLocal(care::local_ptr<T> array, int len)
    }
 }
 
+/************************************************************************
+ * Function  : sortLocal
+ * Purpose   : Sorts exactly N elements in ascending order with a sorting
+ *             network built at compile time. Prefer this over the runtime
+ *             length version when the length is a constant.
+ ************************************************************************/
+template <int N, typename T>
+CARE_HOST_DEVICE inline void sortLocal(care::local_ptr<T> array)
+{
+   T * rawArray = array;
+   care::detail::sortingNetwork<N>(rawArray);
+}
+
 template <typename T>
 CARE_HOST_DEVICE void uniqLocal(care::local_ptr<T> array, int& len);
 
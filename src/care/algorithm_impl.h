@@ -18,9 +18,14 @@
 // declarations) should be included everywhere else.
 
 #include "care/algorithm_decl.h"
+#include "care/atomic.h"
 #include "care/CHAIDataGetter.h"
 #include "care/DefaultMacros.h"
+#include "care/host_algorithm.h"
+#include "care/partition.h"
+#include "care/segmented_reduce.h"
 #include "care/scan.h"
+#include "care/scan_impl.h"
 
 // Other library headers
 #if defined(__CUDACC__)
@@ -33,6 +38,10 @@
 #include "hipcub/hipcub.hpp"
 #endif
 
+// Std library headers
+#include <cstdint>
+#include <cstring>
+
 namespace care {
 
 ///////////////////////////////////////////////////////////////////////////
@@ -118,6 +127,32 @@ CARE_HOST_DEVICE CARE_INLINE bool checkSorted(const care::host_device_ptr<T>& ar
 
 #endif // defined(CARE_ENABLE_IMPLICIT_CONVERSIONS)
 
+#if defined(CARE_GPUCC)
+
+namespace detail {
+
+/************************************************************************
+ * The transform and predicate IntersectArrays hands to TransformCopyIf.
+ * An index of the smaller array is kept if it was found in the larger.
+ ************************************************************************/
+struct IntersectIndex {
+   CARE_HOST_DEVICE int operator()(const int i) const {
+      return i;
+   }
+};
+
+struct IntersectFound {
+   care::host_device_ptr<const int> searches;
+
+   CARE_HOST_DEVICE bool operator()(const int i) const {
+      return searches[i] > -1;
+   }
+};
+
+} // namespace detail
+
+#endif // defined(CARE_GPUCC)
+
 /************************************************************************
  * Function  : IntersectArrays<A,RAJAExec>
  * Author(s) : Peter Robinson, based on IntersectGlobalIDArrays by Al Nichols
@@ -170,6 +205,17 @@ CARE_INLINE void IntersectArrays(RAJADeviceExec,
       checkSorted<T>(slice2, size2, funcname, "arr2") ;
    }
 
+#if !defined(CARE_GPUCC)
+   /* OpenMP: merge path partitioned linear intersection on the host arrays */
+   {
+      const T * a1 = care::host_ptr<const T>(arr1).cdata() + start1;
+      const T * a2 = care::host_ptr<const T>(arr2).cdata() + start2;
+
+      *numMatches = care::detail::parallelIntersectSorted(a1, size1, a2, size2,
+                                                          care::host_ptr<int>(matches1).data(),
+                                                          care::host_ptr<int>(matches2).data());
+   }
+#else // !defined(CARE_GPUCC)
    care::host_device_ptr<int> smallerMatches, largerMatches;
    int larger, smallStart, largeStart;
    care::host_device_ptr<const T> smallerArray, largerArray;
@@ -194,28 +240,25 @@ CARE_INLINE void IntersectArrays(RAJADeviceExec,
    }
 
    /* this avoid thrust and the inherent memory allocation overhead associated with it */
-   care::host_device_ptr<int> searches(smaller + 1,"IntersectArrays searches");
-   care::host_device_ptr<int> matched(smaller + 1, "IntersectArrays matched");
+   care::host_device_ptr<int> searches(smaller, "IntersectArrays searches");
 
-   CARE_STREAM_LOOP(i, 0, smaller + 1) {
-      searches[i] = i != smaller ? BinarySearch<T>(largerArray, largeStart, larger, smallerArray[i + smallStart]) : -1;
-      matched[i] = i != smaller && searches[i] > -1;
+   CARE_STREAM_LOOP(i, 0, smaller) {
+      searches[i] = BinarySearch<T>(largerArray, largeStart, larger, smallerArray[i + smallStart]);
    } CARE_STREAM_LOOP_END
 
-   care::exclusive_scan(RAJAExec{}, matched, nullptr, smaller + 1, 0, true);
+   /* the count and scatter are fused, so there is no matched array to scan or pick from */
+   const int matchCount = TransformCopyIf(RAJADeviceExec{}, smaller, smallerMatches,
+                                          detail::IntersectIndex{}, detail::IntersectFound{searches});
 
-   CARE_STREAM_LOOP(i, 0, smaller) {
-      if (searches[i] > -1) {
-         // matches reported relative to smallStart and largeStart
-         smallerMatches[matched[i]] = i;
-         largerMatches[matched[i]] = searches[i] - largeStart;
-      }
+   CARE_STREAM_LOOP(k, 0, matchCount) {
+      // matches reported relative to smallStart and largeStart
+      largerMatches[k] = searches[smallerMatches[k]] - largeStart;
    } CARE_STREAM_LOOP_END
 
-   *numMatches = matched.pick(smaller);
+   *numMatches = matchCount;
 
-   searches.free(); 
-   matched.free();
+   searches.free();
+#endif // !defined(CARE_GPUCC)
 
    /* change the size of the array */
    /* (reallocing to a size of zero should be the same as freeing
@@ -300,9 +343,6 @@ CARE_INLINE void IntersectArrays(RAJA::seq_exec,
       checkSorted<T>(arr2.cdata() + start2, size2, funcname, "arr2") ;
    }
 
-   int i, j;
-   i = j = 0 ;
-
    /* the host arrays */
    const T * a1, *a2;
    int * m1 = matches1.data();
@@ -313,21 +353,8 @@ CARE_INLINE void IntersectArrays(RAJA::seq_exec,
    a2 = arr2.cdata();
    a2 += start2;
 
-   while (i < size1 && j < size2) {
-      if ((a1)[i] < a2[j]) {
-         ++i;
-      }
-      else if (a2[j] < a1[i]) {
-         ++j;
-      }
-      else {
-         m1[(*numMatches)] = i;
-         m2[(*numMatches)] = j;
-         (*numMatches)++;
-         ++i;
-         ++j;
-      }
-   }
+   /* linear merge, or galloping through the longer array if the sizes differ a lot */
+   *numMatches = care::detail::intersectSorted(a1, size1, a2, size2, m1, m2);
 
    /* change the size of the array */
    if (*numMatches == 0) {
@@ -403,6 +430,404 @@ CARE_INLINE void IntersectArrays(RAJA::seq_exec exec,
                    matches1, matches2, numMatches);
 }
 
+namespace detail {
+
+/************************************************************************
+ * The set operations implemented by SetOperationArrays
+ ************************************************************************/
+enum class set_operation { set_union, set_difference, set_symmetric_difference };
+
+/************************************************************************
+ * The number of merged elements each loop iteration of
+ * SetOperationArrays handles
+ ************************************************************************/
+constexpr int setOperationTileSize = 128;
+
+/************************************************************************
+ * Function  : SetOperationSplit
+ * Purpose   : Merge path search for the split of the first diag elements
+ *             of the merge of a and b (sorted and unique), taking ties from
+ *             a first. If the split falls between equal elements of a and
+ *             b, it is moved past the one in b so that both are handled by
+ *             the same tile.
+ * Returns   : The number of elements of a before the split. The number of
+ *             elements of b before the split is returned in j.
+ ************************************************************************/
+template <typename T>
+CARE_HOST_DEVICE inline int SetOperationSplit(const T * a, const int aLen,
+                                              const T * b, const int bLen,
+                                              const int diag, int & j)
+{
+   int low = diag > bLen ? diag - bLen : 0;
+   int high = diag < aLen ? diag : aLen;
+
+   while (low < high) {
+      const int mid = low + (high - low) / 2;
+
+      if (b[diag - 1 - mid] < a[mid]) {
+         high = mid;
+      }
+      else {
+         low = mid + 1;
+      }
+   }
+
+   j = diag - low;
+
+   if (low > 0 && j < bLen && !(a[low - 1] < b[j])) {
+      ++j;
+   }
+
+   return low;
+}
+
+/************************************************************************
+ * Function  : SetOperationRange
+ * Purpose   : Sequential set operation on a[0, aLen) and b[0, bLen), both
+ *             sorted and unique. The result is written to out unless out
+ *             is nullptr, in which case it is only counted.
+ * Returns   : The number of elements in the result
+ ************************************************************************/
+template <typename T>
+CARE_HOST_DEVICE inline int SetOperationRange(const set_operation op,
+                                              const T * a, const int aLen,
+                                              const T * b, const int bLen,
+                                              T * out)
+{
+   const bool keepB = op != set_operation::set_difference;
+   const bool keepBoth = op == set_operation::set_union;
+
+   int i = 0;
+   int j = 0;
+   int n = 0;
+
+   while (i < aLen && j < bLen) {
+      if (a[i] < b[j]) {
+         if (out) {
+            out[n] = a[i];
+         }
+
+         ++n;
+         ++i;
+      }
+      else if (b[j] < a[i]) {
+         if (keepB) {
+            if (out) {
+               out[n] = b[j];
+            }
+
+            ++n;
+         }
+
+         ++j;
+      }
+      else {
+         if (keepBoth) {
+            if (out) {
+               out[n] = a[i];
+            }
+
+            ++n;
+         }
+
+         ++i;
+         ++j;
+      }
+   }
+
+   for (; i < aLen; ++i, ++n) {
+      if (out) {
+         out[n] = a[i];
+      }
+   }
+
+   if (keepB) {
+      for (; j < bLen; ++j, ++n) {
+         if (out) {
+            out[n] = b[j];
+         }
+      }
+   }
+
+   return n;
+}
+
+/************************************************************************
+ * Function  : SetOperationArrays
+ * Purpose   : Implements UnionArrays, DifferenceArrays and
+ *             SymmetricDifferenceArrays. The merge of the two arrays is cut
+ *             into tiles of setOperationTileSize elements with a merge path
+ *             search, each tile counts its part of the result, the counts
+ *             are exclusive scanned into offsets, and each tile writes its
+ *             part of the result at its offset. The total work is linear.
+ ************************************************************************/
+template <typename Exec, typename T>
+CARE_INLINE void SetOperationArrays(Exec, const set_operation op, const char * funcname,
+                                    care::host_device_ptr<const T> arr1, int size1, int start1,
+                                    care::host_device_ptr<const T> arr2, int size2, int start2,
+                                    care::host_device_ptr<T> &result, int *resultSize)
+{
+   *resultSize = 0;
+   result = nullptr;
+
+   size1 = size1 > 0 ? size1 : 0;
+   size2 = size2 > 0 ? size2 : 0;
+
+   const int total = size1 + size2;
+
+   if (total == 0) {
+      return;
+   }
+
+#ifdef CARE_DEBUG
+   // allowDuplicates is false for these checks by default.
+   care::host_device_ptr<const T> slice1(arr1.slice(start1));
+   care::host_device_ptr<const T> slice2(arr2.slice(start2));
+
+   checkSorted<T>(slice1, size1, funcname, "arr1") ;
+   checkSorted<T>(slice2, size2, funcname, "arr2") ;
+#else
+   (void) funcname;
+#endif
+
+   const int numTiles = (total + setOperationTileSize - 1) / setOperationTileSize;
+
+   care::host_device_ptr<int> splits1(numTiles + 1, "SetOperationArrays splits1");
+   care::host_device_ptr<int> splits2(numTiles + 1, "SetOperationArrays splits2");
+   care::host_device_ptr<int> offsets(numTiles + 1, "SetOperationArrays offsets");
+
+   CARE_LOOP(Exec{}, t, 0, numTiles + 1) {
+      const T * a = care::local_ptr<const T>(arr1) + start1;
+      const T * b = care::local_ptr<const T>(arr2) + start2;
+
+      const int diag = t < numTiles ? t * setOperationTileSize : total;
+
+      int j0 = 0;
+      const int i0 = SetOperationSplit(a, size1, b, size2, diag, j0);
+
+      splits1[t] = i0;
+      splits2[t] = j0;
+
+      if (t < numTiles) {
+         int j1 = 0;
+         const int end = diag + setOperationTileSize < total ? diag + setOperationTileSize : total;
+         const int i1 = SetOperationSplit(a, size1, b, size2, end, j1);
+
+         offsets[t] = SetOperationRange(op, a + i0, i1 - i0, b + j0, j1 - j0, (T *) nullptr);
+      }
+      else {
+         offsets[t] = 0;
+      }
+   } CARE_LOOP_END
+
+   care::exclusive_scan(Exec{}, offsets, nullptr, numTiles + 1, 0, true);
+
+   const int numResults = offsets.pick(numTiles);
+
+   if (numResults > 0) {
+      result = care::host_device_ptr<T>(numResults, funcname);
+
+      CARE_LOOP(Exec{}, t, 0, numTiles) {
+         const T * a = care::local_ptr<const T>(arr1) + start1;
+         const T * b = care::local_ptr<const T>(arr2) + start2;
+         T * out = care::local_ptr<T>(result) + offsets[t];
+
+         SetOperationRange(op, a + splits1[t], splits1[t + 1] - splits1[t],
+                           b + splits2[t], splits2[t + 1] - splits2[t], out);
+      } CARE_LOOP_END
+   }
+
+   offsets.free();
+   splits2.free();
+   splits1.free();
+
+   *resultSize = numResults;
+}
+
+} // namespace detail
+
+#ifdef CARE_PARALLEL_DEVICE
+
+/************************************************************************
+ * Function  : UnionArrays<T,RAJADeviceExec>
+ * Purpose   : Computes the union of two sorted arrays of unique elements.
+ *             This is the parallel overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void UnionArrays(RAJADeviceExec exec,
+                             care::host_device_ptr<const T> arr1, int size1, int start1,
+                             care::host_device_ptr<const T> arr2, int size2, int start2,
+                             care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_union, "UnionArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void UnionArrays(RAJADeviceExec exec,
+                             care::host_device_ptr<T> arr1, int size1, int start1,
+                             care::host_device_ptr<T> arr2, int size2, int start2,
+                             care::host_device_ptr<T> &result, int *resultSize)
+{
+   UnionArrays<T>(exec,
+               care::host_device_ptr<const T>(arr1), size1, start1,
+               care::host_device_ptr<const T>(arr2), size2, start2,
+               result, resultSize);
+}
+
+/************************************************************************
+ * Function  : DifferenceArrays<T,RAJADeviceExec>
+ * Purpose   : Computes the elements of one sorted array of unique elements
+ *             that are not in another.
+ *             This is the parallel overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void DifferenceArrays(RAJADeviceExec exec,
+                                  care::host_device_ptr<const T> arr1, int size1, int start1,
+                                  care::host_device_ptr<const T> arr2, int size2, int start2,
+                                  care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_difference, "DifferenceArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void DifferenceArrays(RAJADeviceExec exec,
+                                  care::host_device_ptr<T> arr1, int size1, int start1,
+                                  care::host_device_ptr<T> arr2, int size2, int start2,
+                                  care::host_device_ptr<T> &result, int *resultSize)
+{
+   DifferenceArrays<T>(exec,
+                    care::host_device_ptr<const T>(arr1), size1, start1,
+                    care::host_device_ptr<const T>(arr2), size2, start2,
+                    result, resultSize);
+}
+
+/************************************************************************
+ * Function  : SymmetricDifferenceArrays<T,RAJADeviceExec>
+ * Purpose   : Computes the elements that are in exactly one of two sorted
+ *             arrays of unique elements.
+ *             This is the parallel overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void SymmetricDifferenceArrays(RAJADeviceExec exec,
+                                           care::host_device_ptr<const T> arr1, int size1, int start1,
+                                           care::host_device_ptr<const T> arr2, int size2, int start2,
+                                           care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_symmetric_difference, "SymmetricDifferenceArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void SymmetricDifferenceArrays(RAJADeviceExec exec,
+                                           care::host_device_ptr<T> arr1, int size1, int start1,
+                                           care::host_device_ptr<T> arr2, int size2, int start2,
+                                           care::host_device_ptr<T> &result, int *resultSize)
+{
+   SymmetricDifferenceArrays<T>(exec,
+                             care::host_device_ptr<const T>(arr1), size1, start1,
+                             care::host_device_ptr<const T>(arr2), size2, start2,
+                             result, resultSize);
+}
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+/************************************************************************
+ * Function  : UnionArrays<T,RAJA::seq_exec>
+ * Purpose   : Computes the union of two sorted arrays of unique elements.
+ *             This is the sequential overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void UnionArrays(RAJA::seq_exec exec,
+                             care::host_device_ptr<const T> arr1, int size1, int start1,
+                             care::host_device_ptr<const T> arr2, int size2, int start2,
+                             care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_union, "UnionArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void UnionArrays(RAJA::seq_exec exec,
+                             care::host_device_ptr<T> arr1, int size1, int start1,
+                             care::host_device_ptr<T> arr2, int size2, int start2,
+                             care::host_device_ptr<T> &result, int *resultSize)
+{
+   UnionArrays<T>(exec,
+               care::host_device_ptr<const T>(arr1), size1, start1,
+               care::host_device_ptr<const T>(arr2), size2, start2,
+               result, resultSize);
+}
+
+/************************************************************************
+ * Function  : DifferenceArrays<T,RAJA::seq_exec>
+ * Purpose   : Computes the elements of one sorted array of unique elements
+ *             that are not in another.
+ *             This is the sequential overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void DifferenceArrays(RAJA::seq_exec exec,
+                                  care::host_device_ptr<const T> arr1, int size1, int start1,
+                                  care::host_device_ptr<const T> arr2, int size2, int start2,
+                                  care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_difference, "DifferenceArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void DifferenceArrays(RAJA::seq_exec exec,
+                                  care::host_device_ptr<T> arr1, int size1, int start1,
+                                  care::host_device_ptr<T> arr2, int size2, int start2,
+                                  care::host_device_ptr<T> &result, int *resultSize)
+{
+   DifferenceArrays<T>(exec,
+                    care::host_device_ptr<const T>(arr1), size1, start1,
+                    care::host_device_ptr<const T>(arr2), size2, start2,
+                    result, resultSize);
+}
+
+/************************************************************************
+ * Function  : SymmetricDifferenceArrays<T,RAJA::seq_exec>
+ * Purpose   : Computes the elements that are in exactly one of two sorted
+ *             arrays of unique elements.
+ *             This is the sequential overload of this method (see
+ *             care::detail::SetOperationArrays).
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void SymmetricDifferenceArrays(RAJA::seq_exec exec,
+                                           care::host_device_ptr<const T> arr1, int size1, int start1,
+                                           care::host_device_ptr<const T> arr2, int size2, int start2,
+                                           care::host_device_ptr<T> &result, int *resultSize)
+{
+   care::detail::SetOperationArrays(exec, care::detail::set_operation::set_symmetric_difference, "SymmetricDifferenceArrays",
+                                    arr1, size1, start1, arr2, size2, start2,
+                                    result, resultSize);
+}
+
+template <typename T>
+CARE_INLINE void SymmetricDifferenceArrays(RAJA::seq_exec exec,
+                                           care::host_device_ptr<T> arr1, int size1, int start1,
+                                           care::host_device_ptr<T> arr2, int size2, int start2,
+                                           care::host_device_ptr<T> &result, int *resultSize)
+{
+   SymmetricDifferenceArrays<T>(exec,
+                             care::host_device_ptr<const T>(arr1), size1, start1,
+                             care::host_device_ptr<const T>(arr2), size2, start2,
+                             result, resultSize);
+}
+
 /************************************************************************
  * Function  : BinarySearch
  * Author(s) : Brad Wallin, Peter Robinson
@@ -511,7 +936,188 @@ CARE_HOST_DEVICE CARE_INLINE int BinarySearch(const care::host_device_ptr<const
    return BinarySearch<mapType>(map.data(), start, mapSize, num, returnUpperBound);
 }
 
+namespace detail {
+
+/************************************************************************
+ * Function  : BranchlessBound
+ * Purpose   : The search loop of BranchlessBinarySearch. Returns the index
+ *             of the first element of map[start, start + mapSize) that is
+ *             not less than num (or greater than num if returnUpperBound),
+ *             or start + mapSize if there is none. mapSize must be
+ *             positive.
+ ************************************************************************/
+template <typename T>
+CARE_HOST_DEVICE CARE_INLINE int BranchlessBound(const T *map, const int start,
+                                                 const int mapSize, const T num,
+                                                 bool returnUpperBound)
+{
+   const T * base = map + start;
+   int len = mapSize;
+
+   while (len > 1) {
+      const int half = len >> 1;
+
+#if !defined(CARE_DEVICE_COMPILE) && (defined(__GNUC__) || defined(__clang__))
+      __builtin_prefetch(base + (half >> 1));
+      __builtin_prefetch(base + half + (half >> 1));
+#endif
+
+      // Upper bound moves past entries equal to num, lower bound does not
+      const bool goRight = returnUpperBound ? !(num < base[half]) : (base[half] < num);
+      base = goRight ? base + half : base;
+      len -= half;
+   }
+
+   const bool pastBase = returnUpperBound ? !(num < *base) : (*base < num);
+   return (int) (base - map) + (pastBase ? 1 : 0);
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : BranchlessBinarySearch
+ * Purpose   : Same arguments and results as BinarySearch, but the search
+ *             loop has a fixed trip count of ceil(log2(mapSize)) and the
+ *             only data dependent operation is a conditional move, so
+ *             there are no branch mispredictions and warps do not diverge.
+ *             On the host the two candidate midpoints of the next step are
+ *             prefetched. If there are duplicates of num in the map, the
+ *             index of the first one is returned.
+ ************************************************************************/
+template <typename T>
+CARE_HOST_DEVICE CARE_INLINE int BranchlessBinarySearch(const T *map, const int start,
+                                                        const int mapSize, const T num,
+                                                        bool returnUpperBound)
+{
+   if ((map == nullptr) || (mapSize <= 0)) {
+      return -1 ;
+   }
+
+   const int k = care::detail::BranchlessBound(map, start, mapSize, num, returnUpperBound);
+
+   if (k >= start + mapSize) {
+      return -1 ;
+   }
+   else if (returnUpperBound || map[k] == num) {
+      return k ;
+   }
+   else {
+      return -1 ;
+   }
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+// The number of sorted queries that share a window of the map in the GPU
+// version of BinarySearchBatch
+constexpr int sortedSearchTileSize = 256;
+
+/************************************************************************
+ * Function  : BinarySearchBatch
+ * Purpose   : Searches a sorted map for each entry of queries and writes
+ *             the result of BinarySearch(map, start, mapSize, queries[i],
+ *             returnUpperBound) to results[i] (results must hold at least
+ *             numQueries entries). Uses BranchlessBinarySearch, so when
+ *             there are duplicates in the map the first match is given.
+ *             If queriesSorted is true (the queries are in ascending
+ *             order), the OpenMP version has each thread gallop forward
+ *             through the map from its previous result instead. The GPU
+ *             version cuts the queries into tiles of sortedSearchTileSize,
+ *             bounds the window of the map each tile can land in, and
+ *             searches only that window, which is small and shared by
+ *             neighboring threads. On the GPU the queries must really be
+ *             in ascending order when queriesSorted is true.
+ *             This is the parallel overload of this method.
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void BinarySearchBatch(RAJADeviceExec,
+                                   care::host_device_ptr<const T> map, const int start, const int mapSize,
+                                   care::host_device_ptr<const T> queries, const int numQueries,
+                                   care::host_device_ptr<int> results,
+                                   bool returnUpperBound, bool queriesSorted)
+{
+   if (numQueries <= 0) {
+      return ;
+   }
+
+   if (queriesSorted && map != nullptr && mapSize > 0) {
+#if !defined(CARE_GPUCC)
+      care::detail::parallelSortedBatchSearch(care::host_ptr<const T>(map).cdata(), start, mapSize,
+                                              care::host_ptr<const T>(queries).cdata(), numQueries,
+                                              care::host_ptr<int>(results).data(),
+                                              returnUpperBound);
+#else
+      // The queries of each tile lie between its first and last query, so
+      // their results lie in the window of the map between the bounds of
+      // those two. The window reaches one past the upper bound of the
+      // last query so that upper bound searches can land on it.
+      const int numTiles = (numQueries + sortedSearchTileSize - 1) / sortedSearchTileSize;
+      care::host_device_ptr<int> windows(2*numTiles, "BinarySearchBatch windows");
+
+      CARE_STREAM_LOOP(t, 0, numTiles) {
+         const int first = t * sortedSearchTileSize;
+         const int last = care::min(first + sortedSearchTileSize, numQueries) - 1;
+         const int upper = care::detail::BranchlessBound<T>(map.data(), start, mapSize, queries[last], true);
+
+         windows[2*t] = care::detail::BranchlessBound<T>(map.data(), start, mapSize, queries[first], false);
+         windows[2*t+1] = care::min(upper + 1, start + mapSize);
+      } CARE_STREAM_LOOP_END
+
+      CARE_STREAM_LOOP(i, 0, numQueries) {
+         const int t = i / sortedSearchTileSize;
+         const int low = windows[2*t];
+         results[i] = BranchlessBinarySearch<T>(map.data(), low, windows[2*t+1] - low, queries[i], returnUpperBound);
+      } CARE_STREAM_LOOP_END
+
+      windows.free();
+#endif
+      return ;
+   }
+
+   CARE_STREAM_LOOP(i, 0, numQueries) {
+      results[i] = BranchlessBinarySearch<T>(map.data(), start, mapSize, queries[i], returnUpperBound);
+   } CARE_STREAM_LOOP_END
+}
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+/************************************************************************
+ * Function  : BinarySearchBatch
+ * Purpose   : Searches a sorted map for each entry of queries and writes
+ *             the result of BinarySearch(map, start, mapSize, queries[i],
+ *             returnUpperBound) to results[i] (results must hold at least
+ *             numQueries entries). If queriesSorted is true (the queries
+ *             are in ascending order), each search gallops forward from
+ *             the previous result instead of starting over.
+ *             This is the sequential overload of this method.
+ ************************************************************************/
+template <typename T>
+CARE_INLINE void BinarySearchBatch(RAJA::seq_exec,
+                                   care::host_device_ptr<const T> map, const int start, const int mapSize,
+                                   care::host_device_ptr<const T> queries, const int numQueries,
+                                   care::host_device_ptr<int> results,
+                                   bool returnUpperBound, bool queriesSorted)
+{
+   if (numQueries <= 0) {
+      return ;
+   }
+
+   if (queriesSorted && map != nullptr && mapSize > 0) {
+      care::detail::sortedBatchSearch(care::host_ptr<const T>(map).cdata(), start, mapSize,
+                                      care::host_ptr<const T>(queries).cdata(), numQueries,
+                                      care::host_ptr<int>(results).data(),
+                                      returnUpperBound);
+   }
+   else {
+      CARE_SEQUENTIAL_LOOP(i, 0, numQueries) {
+         results[i] = BranchlessBinarySearch<T>(map.data(), start, mapSize, queries[i], returnUpperBound);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+}
+
 #ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
 /************************************************************************
  * Function  : uniqArray
  * Author(s) : Peter Robinson
@@ -528,9 +1134,11 @@ CARE_INLINE void uniqArray(RAJADeviceExec, care::host_device_ptr<T, Accessor>  A
       uniq[i] = (int) ((i == len-1) || (Array[i] < Array[i+1] || Array[i+1] < Array[i])) ;
    } CARE_STREAM_LOOP_END
 
-   care::exclusive_scan(RAJADeviceExec{}, uniq, nullptr, len+1, 0, true);
+   chai::ManagedArray<int> uniqCount(1, CARE_SCANVARLENGTHNAME_SPACE);
+   care::exclusive_scan(RAJADeviceExec{}, uniq, nullptr, len+1, 0, true, uniqCount);
    int numUniq;
-   uniq.pick(len, numUniq);
+   care::getFinalScanCountFromPinned(uniqCount, numUniq);
+   uniqCount.free();
    care::host_device_ptr<T> & tmp = outArray;
    tmp.alloc(numUniq);
    CARE_STREAM_LOOP(i, 0, len) {
@@ -566,12 +1174,81 @@ CARE_INLINE int uniqArray(RAJADeviceExec exec, care::host_device_ptr<T, Accessor
    return newLen;
 }
 
-#endif // defined(CARE_PARALLEL_DEVICE)
+#else // defined(CARE_GPUCC)
 
 /************************************************************************
  * Function  : uniqArray
- * Author(s) : Peter Robinson
- * Purpose   : CPU version of uniqArray.
+ * Purpose   : OpenMP version of uniqArray. Each thread counts the unique
+ *             values in its tile of the array, the counts are scanned into
+ *             the position each tile starts writing, and then each thread
+ *             copies its unique values to outArray (see
+ *             care::detail::compactOffsets and care::detail::compactCopy).
+  ************************************************************************/
+template <typename T, template<class A> class Accessor>
+CARE_INLINE void uniqArray(RAJADeviceExec, care::host_device_ptr<T, Accessor>  Array, size_t len,
+                           care::host_device_ptr<T, Accessor> & outArray, int & outLen, bool noCopy)
+{
+   typedef typename CHAIDataGetter<T, RAJA::seq_exec>::raw_type RawType;
+
+   outArray = nullptr;
+   outLen = 0;
+
+   if (len > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      const RawType * rawData = getter.getRawArrayData(Array);
+      const care::detail::uniqKeep<RawType> keep {rawData};
+
+      std::vector<size_t> offsets;
+      outLen = (int) care::detail::compactOffsets(len, keep, true, offsets);
+      outArray = care::host_device_ptr<T, Accessor>(outLen, "uniq_outArray");
+      care::detail::compactCopy(rawData, len, keep, offsets, getter.getRawArrayData(outArray));
+   }
+
+   (void) noCopy;
+}
+
+/************************************************************************
+ * Function  : uniqArray
+ * Purpose   : OpenMP version of uniqArray, with in-place semantics. With
+ *             noCopy, the array is compacted in place without a temporary
+ *             (see care::detail::compactInPlace) and the data left at the
+ *             end of the array is unspecified. Otherwise the unique values
+ *             are gathered into a temporary the size of the result and
+ *             copied back, leaving the end of the array untouched.
+  ************************************************************************/
+template <typename T, template<class A> class Accessor>
+CARE_INLINE int uniqArray(RAJADeviceExec exec, care::host_device_ptr<T, Accessor> & Array, size_t len, bool noCopy)
+{
+   typedef typename CHAIDataGetter<T, RAJA::seq_exec>::raw_type RawType;
+
+   int newLength = 0;
+
+   if (len > 0) {
+      if (noCopy) {
+         CHAIDataGetter<T, RAJA::seq_exec> getter {};
+         RawType * rawData = getter.getRawArrayData(Array);
+         const care::detail::uniqKeep<RawType> keep {rawData};
+         newLength = (int) care::detail::compactInPlace(rawData, len, keep, true);
+      }
+      else {
+         care::host_device_ptr<T, Accessor> tmp;
+         uniqArray(exec, Array, len, tmp, newLength);
+         ArrayCopy<T, Accessor>(Array, tmp, newLength);
+         tmp.free();
+      }
+   }
+
+   return newLength;
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+/************************************************************************
+ * Function  : uniqArray
+ * Author(s) : Peter Robinson
+ * Purpose   : CPU version of uniqArray.
   ************************************************************************/
 template <typename T, template<class A> class Accessor>
 CARE_INLINE void uniqArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> Array, size_t len,
@@ -611,23 +1288,24 @@ CARE_INLINE void uniqArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> Ar
  * Author(s) : Peter Robinson
  * Purpose   : CPU version of uniqArray, with in-place semantics. Set noCopy to true
  *             if you don't care about data left at the end of the array after the uniq.
+ *             The array is compacted in place without a temporary (see
+ *             care::detail::compactInPlace), which sequentially never writes
+ *             past the unique values, so noCopy makes no difference here.
   ************************************************************************/
 template <typename T, template<class A> class Accessor>
 CARE_INLINE int uniqArray(RAJA::seq_exec exec, care::host_device_ptr<T, Accessor> & Array, size_t len, bool noCopy)
 {
+   typedef typename CHAIDataGetter<T, RAJA::seq_exec>::raw_type RawType;
+
    int newLength = 0;
    if (len > 0) {
-      care::host_device_ptr<T, Accessor> tmp;
-      uniqArray<T, Accessor>(exec, Array, len, tmp, newLength);
-      if (noCopy) {
-         Array.free();
-         Array = tmp;
-      }
-      else {
-         ArrayCopy<T>(RAJA::seq_exec {}, Array, tmp, newLength);
-         tmp.free();
-      }
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      RawType * rawData = getter.getRawArrayData(Array);
+      const care::detail::uniqKeep<RawType> keep {rawData};
+      newLength = (int) care::detail::compactInPlace(rawData, len, keep, false);
    }
+   (void) exec;
+   (void) noCopy;
    return newLength;
 }
 
@@ -709,17 +1387,30 @@ CARE_INLINE void radixSortArray(care::host_device_ptr<T, Accessor> & Array, size
 }
 #else // defined(CARE_GPUCC)
 
-// TODO openMP parallel implementation
+/************************************************************************
+ * Function  : sortArray
+ * Purpose   : OpenMP version of sortArray. Large arrays of integers
+ *             (including globalIDs) get a radix sort with per thread
+ *             histograms (see care::detail::radixSort). Otherwise each
+ *             thread sorts a run of the array and the runs are merged in
+ *             parallel (see care::detail::parallelSort). Small arrays are
+ *             sorted with std::sort.
+  ************************************************************************/
 template <typename T, template<class A> class Accessor>
 CARE_INLINE void sortArray(RAJADeviceExec, care::host_device_ptr<T, Accessor> & Array, size_t len, int start, bool noCopy)
 {
-   sortArray(RAJA::seq_exec{}, Array, len, start, noCopy);
+   CHAIDataGetter<T, RAJA::seq_exec> getter {};
+   auto * rawData = getter.getRawArrayData(Array)+start;
+   care::detail::hostSort(rawData, len, true);
+   (void) noCopy;
 }
 
 template <typename T, template<class A> class Accessor>
 CARE_INLINE void sortArray(RAJADeviceExec, care::host_device_ptr<T, Accessor> &Array, size_t len)
 {
-   sortArray(RAJA::seq_exec{}, Array, len);
+   CHAIDataGetter<T, RAJA::seq_exec> getter {};
+   auto * rawData = getter.getRawArrayData(Array);
+   care::detail::hostSort(rawData, len, true);
 }
 
 #endif // defined(CARE_GPUCC)
@@ -729,14 +1420,16 @@ CARE_INLINE void sortArray(RAJADeviceExec, care::host_device_ptr<T, Accessor> &A
 /************************************************************************
  * Function  : sortArray
  * Author(s) : Peter Robinson
- * Purpose   : CPU version of sortArray. Calls std::sort
+ * Purpose   : CPU version of sortArray. Large arrays of integers
+ *             (including globalIDs) get a radix sort, everything else
+ *             calls std::sort
   ************************************************************************/
 template <typename T, template<class A> class Accessor>
 CARE_INLINE void sortArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> & Array, size_t len, int start, bool noCopy)
 {
    CHAIDataGetter<T, RAJA::seq_exec> getter {};
    auto * rawData = getter.getRawArrayData(Array)+start;
-   std::sort(rawData, rawData+len);
+   care::detail::hostSort(rawData, len, false);
    (void) noCopy;
 }
 
@@ -745,9 +1438,897 @@ CARE_INLINE void sortArray(RAJA::seq_exec, care::host_device_ptr<T, Accessor> &A
 {
    CHAIDataGetter<T, RAJA::seq_exec> getter {};
    auto * rawData = getter.getRawArrayData(Array);
-   std::sort(rawData, rawData+len);
+   care::detail::hostSort(rawData, len, false);
+}
+
+namespace detail {
+
+/************************************************************************
+ * Function  : TopKHost
+ * Purpose   : Host version of TopK. Selects the k smallest with per
+ *             thread heaps (see care::detail::selectSmallest).
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void TopKHost(care::host_device_ptr<const T> array, int len, int k,
+                          care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices,
+                          bool parallel)
+{
+   values = nullptr;
+   indices = nullptr;
+
+   if (len <= 0 || k <= 0) {
+      return;
+   }
+
+   std::vector<KeyIndex<T>> smallest;
+   selectSmallest(care::host_ptr<const T>(array).cdata(), (size_t) len, (size_t) k, parallel, smallest);
+
+   const int numSelected = (int) smallest.size();
+
+   values = care::host_device_ptr<T>(numSelected, "TopK values");
+   indices = care::host_device_ptr<int>(numSelected, "TopK indices");
+
+   T * hostValues = care::host_ptr<T>(values).data();
+   int * hostIndices = care::host_ptr<int>(indices).data();
+
+   for (int i = 0; i < numSelected; ++i) {
+      hostValues[i] = smallest[i].key;
+      hostIndices[i] = (int) smallest[i].index;
+   }
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : NthElement, PartialSort, TopK
+ * Purpose   : CPU versions of the selection algorithms.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void NthElement(RAJA::seq_exec, care::host_device_ptr<T> array, int len, int n)
+{
+   if (len > 0 && n >= 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      care::detail::nthElement(getter.getRawArrayData(array), (size_t) len, (size_t) n, false);
+   }
+}
+
+template <typename T>
+CARE_INLINE void PartialSort(RAJA::seq_exec, care::host_device_ptr<T> array, int len, int k)
+{
+   if (len > 0 && k > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      care::detail::partialSort(getter.getRawArrayData(array), (size_t) len, (size_t) k, false);
+   }
+}
+
+template <typename T>
+CARE_INLINE void TopK(RAJA::seq_exec, care::host_device_ptr<const T> array, int len, int k,
+                      care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices)
+{
+   care::detail::TopKHost(array, len, k, values, indices, false);
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+namespace detail {
+
+// Defined with Histogram and BinCount below
+template <typename T, typename Bin>
+CARE_INLINE void CountBins(RAJADeviceExec, care::host_device_ptr<const T> values, int n,
+                           int nbins, Bin bin, care::host_device_ptr<int> counts);
+
+/************************************************************************
+ * The unsigned integer with the same size as an arithmetic type
+  ************************************************************************/
+template <int Size> struct RadixSelectUnsigned;
+template <> struct RadixSelectUnsigned<1> { typedef uint8_t type; };
+template <> struct RadixSelectUnsigned<2> { typedef uint16_t type; };
+template <> struct RadixSelectUnsigned<4> { typedef uint32_t type; };
+template <> struct RadixSelectUnsigned<8> { typedef uint64_t type; };
+
+/************************************************************************
+ * Maps a value to unsigned bits in the same order: the sign bit of
+ * signed integers is flipped, and floating point values have every bit
+ * flipped when negative and just the sign bit flipped otherwise.
+  ************************************************************************/
+template <typename T>
+struct RadixSelectBits {
+   static_assert(std::is_arithmetic<T>::value, "The GPU selection algorithms require arithmetic types");
+
+   typedef typename RadixSelectUnsigned<sizeof(T)>::type type;
+
+   CARE_HOST_DEVICE static type get(const T value) {
+      const type signBit = (type) ((type) 1 << (sizeof(type) * 8 - 1));
+      type bits;
+      memcpy(&bits, &value, sizeof(T));
+
+      if (std::is_floating_point<T>::value) {
+         return (bits & signBit) ? (type) ~bits : (type) (bits | signBit);
+      }
+      else {
+         return std::is_signed<T>::value ? (type) (bits ^ signBit) : bits;
+      }
+   }
+};
+
+/************************************************************************
+ * The number of bits RadixSelect looks at per pass
+  ************************************************************************/
+constexpr int radixSelectDigitBits = 8;
+
+/************************************************************************
+ * The digit of a value in the current pass of RadixSelect, or -1 if its
+ * higher digits do not match the ones selected so far
+  ************************************************************************/
+template <typename T>
+struct RadixSelectBin {
+   typedef typename RadixSelectBits<T>::type Bits;
+
+   Bits prefix;
+   Bits highMask;
+   int shift;
+
+   CARE_HOST_DEVICE int operator()(const T value) const {
+      const Bits bits = RadixSelectBits<T>::get(value);
+
+      if ((bits ^ prefix) & highMask) {
+         return -1;
+      }
+
+      return (int) ((bits >> shift) & ((1 << radixSelectDigitBits) - 1));
+   }
+};
+
+/************************************************************************
+ * Puts values below, at and above the selected bits in buckets 0, 1, 2
+  ************************************************************************/
+template <typename T>
+struct RadixSelectBucket {
+   typename RadixSelectBits<T>::type selected;
+
+   CARE_HOST_DEVICE int operator()(const T value) const {
+      const typename RadixSelectBits<T>::type bits = RadixSelectBits<T>::get(value);
+      return bits < selected ? 0 : (bits == selected ? 1 : 2);
+   }
+};
+
+/************************************************************************
+ * Whether array[i] is below or at the selected bits, for TopK
+  ************************************************************************/
+template <typename T>
+struct RadixSelectBelow {
+   care::host_device_ptr<const T> array;
+   typename RadixSelectBits<T>::type selected;
+
+   CARE_HOST_DEVICE bool operator()(const int i) const {
+      return RadixSelectBits<T>::get(array[i]) < selected;
+   }
+};
+
+template <typename T>
+struct RadixSelectAt {
+   care::host_device_ptr<const T> array;
+   typename RadixSelectBits<T>::type selected;
+
+   CARE_HOST_DEVICE bool operator()(const int i) const {
+      return RadixSelectBits<T>::get(array[i]) == selected;
+   }
+};
+
+struct RadixSelectIndex {
+   CARE_HOST_DEVICE int operator()(const int i) const {
+      return i;
+   }
+};
+
+/************************************************************************
+ * Function  : RadixSelect
+ * Purpose   : Finds the bits (see RadixSelectBits) of the element of rank
+ *             0 <= rank < len that would be at array[rank] if array were
+ *             sorted, and how many elements are less than it, without
+ *             moving anything. Each pass counts the next 8 bits of the
+ *             elements whose higher bits match the ones selected so far
+ *             (see CountBins), and the 256 counts are read on the host to
+ *             pick the digit holding the rank. That is sizeof(T) passes
+ *             over the array and no temporaries but the counts.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE typename RadixSelectBits<T>::type RadixSelect(care::host_device_ptr<const T> array, int len,
+                                                          int rank, int & numLess)
+{
+   typedef typename RadixSelectBits<T>::type Bits;
+
+   const int numDigits = 1 << radixSelectDigitBits;
+   care::host_device_ptr<int> counts(numDigits, "RadixSelect counts");
+
+   Bits prefix = 0;
+   Bits highMask = 0;
+   numLess = 0;
+
+   for (int shift = (int) sizeof(Bits) * 8 - radixSelectDigitBits; shift >= 0; shift -= radixSelectDigitBits) {
+      CountBins(RAJADeviceExec{}, array, len, numDigits, RadixSelectBin<T>{prefix, highMask, shift}, counts);
+
+      const int * hostCounts = care::host_ptr<const int>(counts).cdata();
+      int digit = 0;
+
+      while (rank >= hostCounts[digit]) {
+         rank -= hostCounts[digit];
+         numLess += hostCounts[digit];
+         ++digit;
+      }
+
+      prefix = (Bits) (prefix | ((Bits) digit << shift));
+      highMask = (Bits) (highMask | ((Bits) (numDigits - 1) << shift));
+   }
+
+   counts.free();
+
+   return prefix;
+}
+
+/************************************************************************
+ * Function  : RadixPartition
+ * Purpose   : Stable partition of array into the elements less than, equal
+ *             to and greater than the element of the given rank.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void RadixPartition(care::host_device_ptr<T> array, int len, int rank)
+{
+   int numLess = 0;
+   const typename RadixSelectBits<T>::type selected =
+      RadixSelect(care::host_device_ptr<const T>(array), len, rank, numLess);
+
+   care::host_device_ptr<int> offsets(4, "RadixPartition offsets");
+   PartitionBuckets(RAJADeviceExec{}, array, nullptr, len, 3, RadixSelectBucket<T>{selected}, offsets);
+   offsets.free();
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : NthElement, PartialSort
+ * Purpose   : GPU versions of the selection algorithms. A radix select
+ *             finds the element of the wanted rank (see
+ *             care::detail::RadixSelect), then the array is partitioned
+ *             around it. PartialSort then radix sorts just the first k
+ *             elements.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void NthElement(RAJADeviceExec, care::host_device_ptr<T> array, int len, int n)
+{
+   if (len > 0 && n >= 0 && n < len) {
+      care::detail::RadixPartition(array, len, n);
+   }
+}
+
+template <typename T>
+CARE_INLINE void PartialSort(RAJADeviceExec, care::host_device_ptr<T> array, int len, int k)
+{
+   if (len > 0 && k > 0) {
+      if (k < len) {
+         care::detail::RadixPartition(array, len, k - 1);
+      }
+
+      radixSortArray(array, k < len ? k : len, 0, false);
+   }
+}
+
+/************************************************************************
+ * Function  : TopK
+ * Purpose   : GPU version of TopK. A radix select finds the k-th smallest
+ *             element, the positions of the smaller elements and of the
+ *             first equal ones are gathered in order (see
+ *             TransformCopyIf), and those k pairs are radix sorted by
+ *             value with cub::DeviceRadixSort::SortPairs, which is
+ *             stable. The temporaries are all of length k.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void TopK(RAJADeviceExec, care::host_device_ptr<const T> array, int len, int k,
+                      care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices)
+{
+   values = nullptr;
+   indices = nullptr;
+
+   if (len <= 0 || k <= 0) {
+      return;
+   }
+
+   const int numSelected = k < len ? k : len;
+
+   int numLess = 0;
+   const typename care::detail::RadixSelectBits<T>::type selected =
+      care::detail::RadixSelect(array, len, numSelected - 1, numLess);
+
+   care::host_device_ptr<int> positions(numSelected, "TopK positions");
+   care::host_device_ptr<int> equalPositions(positions.slice(numLess));
+
+   care::TransformCopyIf(RAJADeviceExec{}, len, positions, care::detail::RadixSelectIndex{},
+                         care::detail::RadixSelectBelow<T>{array, selected});
+   care::detail::TransformCopyFirstIf(RAJADeviceExec{}, len, numSelected - numLess, equalPositions,
+                                      care::detail::RadixSelectIndex{},
+                                      care::detail::RadixSelectAt<T>{array, selected});
+
+   care::host_device_ptr<T> unsortedValues(numSelected, "TopK unsortedValues");
+
+   CARE_STREAM_LOOP(i, 0, numSelected) {
+      unsortedValues[i] = array[positions[i]];
+   } CARE_STREAM_LOOP_END
+
+   values = care::host_device_ptr<T>(numSelected, "TopK values");
+   indices = care::host_device_ptr<int>(numSelected, "TopK indices");
+
+   CHAIDataGetter<T, RAJADeviceExec> getter {};
+   CHAIDataGetter<int, RAJADeviceExec> intGetter {};
+   CHAIDataGetter<char, RAJADeviceExec> charGetter {};
+
+   auto * rawUnsortedValues = getter.getRawArrayData(unsortedValues);
+   auto * rawValues = getter.getRawArrayData(values);
+   auto * rawPositions = intGetter.getRawArrayData(positions);
+   auto * rawIndices = intGetter.getRawArrayData(indices);
+
+   // get the temp storage length
+   char * d_temp_storage = nullptr;
+   size_t temp_storage_bytes = 0;
+#if defined(__CUDACC__)
+   cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawUnsortedValues, rawValues, rawPositions, rawIndices, numSelected);
+#elif defined(__HIPCC__)
+   hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                      rawUnsortedValues, rawValues, rawPositions, rawIndices, numSelected);
+#endif
+
+   // allocate the temp storage
+   care::host_device_ptr<char> tmpManaged(temp_storage_bytes, "TopK tmpManaged");
+   d_temp_storage = charGetter.getRawArrayData(tmpManaged);
+
+   // do the sort
+#if defined(__CUDACC__)
+   cub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                   rawUnsortedValues, rawValues, rawPositions, rawIndices, numSelected);
+#elif defined(__HIPCC__)
+   hipcub::DeviceRadixSort::SortPairs((void *)d_temp_storage, temp_storage_bytes,
+                                      rawUnsortedValues, rawValues, rawPositions, rawIndices, numSelected);
+#endif
+
+   tmpManaged.free();
+   unsortedValues.free();
+   positions.free();
+}
+
+#else // defined(CARE_GPUCC)
+
+/************************************************************************
+ * Function  : NthElement, PartialSort, TopK
+ * Purpose   : OpenMP versions of the selection algorithms. Each thread
+ *             keeps a heap of the k smallest in its part of the array and
+ *             the heaps are merged (see care::detail::selectSmallest).
+ *             When k is too large for that to pay off, these fall back to
+ *             std::nth_element and std::partial_sort.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void NthElement(RAJADeviceExec, care::host_device_ptr<T> array, int len, int n)
+{
+   if (len > 0 && n >= 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      care::detail::nthElement(getter.getRawArrayData(array), (size_t) len, (size_t) n, true);
+   }
+}
+
+template <typename T>
+CARE_INLINE void PartialSort(RAJADeviceExec, care::host_device_ptr<T> array, int len, int k)
+{
+   if (len > 0 && k > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      care::detail::partialSort(getter.getRawArrayData(array), (size_t) len, (size_t) k, true);
+   }
+}
+
+template <typename T>
+CARE_INLINE void TopK(RAJADeviceExec, care::host_device_ptr<const T> array, int len, int k,
+                      care::host_device_ptr<T> & values, care::host_device_ptr<int> & indices)
+{
+   care::detail::TopKHost(array, len, k, values, indices, true);
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+/************************************************************************
+ * Function  : sortSegments
+ * Purpose   : CPU version of sortSegments. Sorts each segment in turn
+ *             (see care::detail::sortSegments).
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void sortSegments(RAJA::seq_exec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments)
+{
+   if (numSegments > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      auto * rawData = getter.getRawArrayData(array);
+      const int * rawOffsets = care::host_ptr<int const>(offsets).cdata();
+      care::detail::sortSegments(rawData, rawOffsets, numSegments, false);
+   }
+}
+
+/************************************************************************
+ * Function  : uniqSegments
+ * Purpose   : CPU version of uniqSegments.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void uniqSegments(RAJA::seq_exec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments,
+                              care::host_device_ptr<int> lengths)
+{
+   if (numSegments > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      auto * rawData = getter.getRawArrayData(array);
+      const int * rawOffsets = care::host_ptr<int const>(offsets).cdata();
+      int * rawLengths = care::host_ptr<int>(lengths).data();
+      care::detail::uniqSegments(rawData, rawOffsets, numSegments, rawLengths, false);
+   }
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+namespace detail {
+
+/************************************************************************
+ * Function  : selectSegments
+ * Purpose   : Gathers the bounds of the segments with at least minLen and
+ *             fewer than maxLen elements into begins and ends, which are
+ *             allocated here when any segment qualifies.
+ * Returns   : The number of segments selected
+  ************************************************************************/
+inline int selectSegments(care::host_device_ptr<int const> offsets, int numSegments,
+                          int minLen, int maxLen,
+                          care::host_device_ptr<int> & begins, care::host_device_ptr<int> & ends)
+{
+   care::host_device_ptr<int> selected(numSegments + 1, "selectSegments selected");
+
+   CARE_STREAM_LOOP(s, 0, numSegments) {
+      const int len = offsets[s + 1] - offsets[s];
+      selected[s] = (len >= minLen && len < maxLen) ? 1 : 0;
+   } CARE_STREAM_LOOP_END
+
+   care::exclusive_scan(RAJADeviceExec{}, selected, nullptr, numSegments + 1, 0, true);
+
+   const int count = selected.pick(numSegments);
+
+   if (count > 0) {
+      begins = care::host_device_ptr<int>(count, "selectSegments begins");
+      ends = care::host_device_ptr<int>(count, "selectSegments ends");
+
+      CARE_STREAM_LOOP(s, 0, numSegments) {
+         const int k = selected[s];
+
+         if (selected[s + 1] != k) {
+            begins[k] = offsets[s];
+            ends[k] = offsets[s + 1];
+         }
+      } CARE_STREAM_LOOP_END
+   }
+
+   selected.free();
+   return count;
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : sortSegments
+ * Purpose   : GPU version of sortSegments. Segments are sorted with one
+ *             of three strategies depending on their length:
+ *             - tiny segments get a sorting network on a single thread,
+ *             - medium segments are batched into one segmented radix
+ *               sort, which sorts each segment with a thread block,
+ *             - large segments would tie up a single block, so each gets
+ *               a device wide radix sort of its own.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void sortSegments(RAJADeviceExec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments)
+{
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const int tinySize = care::detail::maxSortingNetworkSize;
+   const int largeSize = 1 << 16;
+
+   CARE_STREAM_LOOP(s, 0, numSegments) {
+      const int begin = offsets[s];
+      const int len = offsets[s + 1] - begin;
+
+      if (len > 1 && len <= tinySize) {
+         care::detail::sortingNetwork(array.data() + begin, len);
+      }
+   } CARE_STREAM_LOOP_END
+
+   care::host_device_ptr<int> begins, ends;
+   const int numMedium = care::detail::selectSegments(offsets, numSegments, tinySize + 1, largeSize, begins, ends);
+
+   if (numMedium > 0) {
+      const int numItems = offsets.pick(numSegments);
+
+      // The segmented sort is out of place, and only writes within the
+      // selected segments
+      care::host_device_ptr<T> keysIn(numItems, "sortSegments keysIn");
+      ArrayCopy<T>(RAJADeviceExec{}, keysIn, array, numItems);
+
+      CHAIDataGetter<T, RAJADeviceExec> getter {};
+      CHAIDataGetter<int, RAJADeviceExec> intGetter {};
+      CHAIDataGetter<char, RAJADeviceExec> charGetter {};
+      auto * rawKeysIn = getter.getRawArrayData(keysIn);
+      auto * rawKeysOut = getter.getRawArrayData(array);
+      int * rawBegins = intGetter.getRawArrayData(begins);
+      int * rawEnds = intGetter.getRawArrayData(ends);
+
+      // get the temp storage length
+      char * d_temp_storage = nullptr;
+      size_t temp_storage_bytes = 0;
+#if defined(__CUDACC__)
+      cub::DeviceSegmentedRadixSort::SortKeys((void *)d_temp_storage, temp_storage_bytes, rawKeysIn, rawKeysOut,
+                                              numItems, numMedium, rawBegins, rawEnds);
+#elif defined(__HIPCC__)
+      hipcub::DeviceSegmentedRadixSort::SortKeys((void *)d_temp_storage, temp_storage_bytes, rawKeysIn, rawKeysOut,
+                                                 numItems, numMedium, rawBegins, rawEnds);
+#endif
+
+      // allocate the temp storage
+      care::host_device_ptr<char> tmpManaged(temp_storage_bytes, "sortSegments tmpManaged");
+      d_temp_storage = charGetter.getRawArrayData(tmpManaged);
+
+      // do the sort
+#if defined(__CUDACC__)
+      cub::DeviceSegmentedRadixSort::SortKeys((void *)d_temp_storage, temp_storage_bytes, rawKeysIn, rawKeysOut,
+                                              numItems, numMedium, rawBegins, rawEnds);
+#elif defined(__HIPCC__)
+      hipcub::DeviceSegmentedRadixSort::SortKeys((void *)d_temp_storage, temp_storage_bytes, rawKeysIn, rawKeysOut,
+                                                 numItems, numMedium, rawBegins, rawEnds);
+#endif
+
+      tmpManaged.free();
+      keysIn.free();
+      ends.free();
+      begins.free();
+   }
+
+   const int numLarge = care::detail::selectSegments(offsets, numSegments, largeSize, std::numeric_limits<int>::max(), begins, ends);
+
+   if (numLarge > 0) {
+      care::host_ptr<int> hostBegins = begins;
+      care::host_ptr<int> hostEnds = ends;
+
+      for (int k = 0; k < numLarge; ++k) {
+         radixSortArray(array, hostEnds[k] - hostBegins[k], hostBegins[k], false);
+      }
+
+      ends.free();
+      begins.free();
+   }
+}
+
+/************************************************************************
+ * Function  : uniqSegments
+ * Purpose   : GPU version of uniqSegments. Works one element per thread
+ *             so that long segments do not serialize: the first element
+ *             of each segment and every element that differs from its
+ *             predecessor are flagged, a scan of the flags gives the
+ *             destinations, and the flagged elements are scattered to
+ *             the front of their segments.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void uniqSegments(RAJADeviceExec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments,
+                              care::host_device_ptr<int> lengths)
+{
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const int first = offsets.pick(0);
+   const int numItems = offsets.pick(numSegments) - first;
+
+   care::host_device_ptr<int> keep(numItems + 1, "uniqSegments keep");
+
+   CARE_STREAM_LOOP(i, 0, numItems) {
+      keep[i] = (i == 0 || array[first + i] != array[first + i - 1]) ? 1 : 0;
+   } CARE_STREAM_LOOP_END
+
+   CARE_STREAM_LOOP(s, 0, numSegments) {
+      if (offsets[s] < offsets[s + 1]) {
+         keep[offsets[s] - first] = 1;
+      }
+   } CARE_STREAM_LOOP_END
+
+   // The last entry is only written by the scan
+   care::exclusive_scan(RAJADeviceExec{}, keep, nullptr, numItems + 1, 0, true);
+
+   CARE_STREAM_LOOP(s, 0, numSegments) {
+      lengths[s] = keep[offsets[s + 1] - first] - keep[offsets[s] - first];
+   } CARE_STREAM_LOOP_END
+
+   // Scatter from a copy, since the destinations overlap the sources
+   care::host_device_ptr<T> source(numItems, "uniqSegments source");
+   ArrayCopy<T>(RAJADeviceExec{}, source, array, numItems, 0, first);
+
+   CARE_STREAM_LOOP(i, 0, numItems) {
+      if (keep[i + 1] != keep[i]) {
+         // Find the segment holding element i
+         int low = 0;
+         int high = numSegments - 1;
+
+         while (low < high) {
+            const int mid = (low + high + 1) / 2;
+
+            if (offsets[mid] <= first + i) {
+               low = mid;
+            }
+            else {
+               high = mid - 1;
+            }
+         }
+
+         const int begin = offsets[low];
+         array[begin + keep[i] - keep[begin - first]] = source[i];
+      }
+   } CARE_STREAM_LOOP_END
+
+   source.free();
+   keep.free();
+}
+
+#else // defined(CARE_GPUCC)
+
+/************************************************************************
+ * Function  : sortSegments
+ * Purpose   : OpenMP version of sortSegments. Short and medium segments
+ *             are distributed over the threads and long segments are
+ *             each sorted with all threads (see care::detail::sortSegments).
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void sortSegments(RAJADeviceExec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments)
+{
+   if (numSegments > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      auto * rawData = getter.getRawArrayData(array);
+      const int * rawOffsets = care::host_ptr<int const>(offsets).cdata();
+      care::detail::sortSegments(rawData, rawOffsets, numSegments, true);
+   }
+}
+
+/************************************************************************
+ * Function  : uniqSegments
+ * Purpose   : OpenMP version of uniqSegments.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void uniqSegments(RAJADeviceExec, care::host_device_ptr<T> array,
+                              care::host_device_ptr<int const> offsets, int numSegments,
+                              care::host_device_ptr<int> lengths)
+{
+   if (numSegments > 0) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      auto * rawData = getter.getRawArrayData(array);
+      const int * rawOffsets = care::host_ptr<int const>(offsets).cdata();
+      int * rawLengths = care::host_ptr<int>(lengths).data();
+      care::detail::uniqSegments(rawData, rawOffsets, numSegments, rawLengths, true);
+   }
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+namespace detail {
+
+/************************************************************************
+ * Function  : MergeSortedRuns
+ * Purpose   : Host version of MergeSorted. Merges the runs with
+ *             care::detail::multiwayMerge into a newly allocated result,
+ *             which is shrunk to fit if uniq dropped any duplicates.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSortedRuns(const std::vector<const T *> & begins,
+                                 const std::vector<const T *> & ends,
+                                 care::host_device_ptr<T> & result, int & resultLen,
+                                 bool uniq, bool parallel)
+{
+   size_t total = 0;
+
+   for (size_t r = 0; r < begins.size(); ++r) {
+      total += (size_t) (ends[r] - begins[r]);
+   }
+
+   result = nullptr;
+   resultLen = 0;
+
+   if (total > 0) {
+      result = care::host_device_ptr<T>(total, "MergeSorted result");
+
+      const size_t numWritten =
+         care::detail::multiwayMerge(begins.data(), ends.data(), (int) begins.size(),
+                                     care::host_ptr<T>(result).data(), uniq, parallel);
+
+      if (numWritten < total) {
+         result.realloc(numWritten);
+      }
+
+      resultLen = (int) numWritten;
+   }
+}
+
+/************************************************************************
+ * Function  : MergeSortedSegments
+ * Purpose   : Host version of MergeSorted for the segments of one array.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSortedSegments(care::host_device_ptr<const T> array,
+                                     care::host_device_ptr<int const> offsets, int numSegments,
+                                     care::host_device_ptr<T> & result, int & resultLen,
+                                     bool uniq, bool parallel)
+{
+   const int numRuns = numSegments > 0 ? numSegments : 0;
+   std::vector<const T *> begins(numRuns);
+   std::vector<const T *> ends(numRuns);
+
+   if (numRuns > 0) {
+      const T * data = care::host_ptr<const T>(array).cdata();
+      const int * hostOffsets = care::host_ptr<int const>(offsets).cdata();
+
+      for (int s = 0; s < numRuns; ++s) {
+         begins[s] = data + hostOffsets[s];
+         ends[s] = data + hostOffsets[s + 1];
+      }
+   }
+
+   MergeSortedRuns(begins, ends, result, resultLen, uniq, parallel);
+}
+
+/************************************************************************
+ * Function  : MergeSortedArrays
+ * Purpose   : Host version of MergeSorted for separate arrays.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSortedArrays(const std::vector<care::host_device_ptr<const T>> & arrays,
+                                   const std::vector<int> & lengths,
+                                   care::host_device_ptr<T> & result, int & resultLen,
+                                   bool uniq, bool parallel)
+{
+   std::vector<const T *> begins;
+   std::vector<const T *> ends;
+
+   for (size_t r = 0; r < arrays.size(); ++r) {
+      if (lengths[r] > 0) {
+         begins.push_back(care::host_ptr<const T>(arrays[r]).cdata());
+         ends.push_back(begins.back() + lengths[r]);
+      }
+   }
+
+   MergeSortedRuns(begins, ends, result, resultLen, uniq, parallel);
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : MergeSorted
+ * Purpose   : CPU version of MergeSorted. Merges the runs with a loser
+ *             tree (see care::detail::multiwayMerge).
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const T> array,
+                             care::host_device_ptr<int const> offsets, int numSegments,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   care::detail::MergeSortedSegments(array, offsets, numSegments, result, resultLen, uniq, false);
+}
+
+template <typename T>
+CARE_INLINE void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const T>> & arrays,
+                             const std::vector<int> & lengths,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   care::detail::MergeSortedArrays(arrays, lengths, result, resultLen, uniq, false);
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+/************************************************************************
+ * Function  : MergeSorted
+ * Purpose   : GPU version of MergeSorted. The runs are gathered into the
+ *             result, which is then radix sorted (and uniqued if asked),
+ *             since a radix sort does not gain from the input being in
+ *             sorted runs but is still the fastest way to sort on the GPU.
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSorted(RAJADeviceExec exec, care::host_device_ptr<const T> array,
+                             care::host_device_ptr<int const> offsets, int numSegments,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   result = nullptr;
+   resultLen = 0;
+
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const int first = offsets.pick(0);
+   const int total = offsets.pick(numSegments) - first;
+
+   if (total > 0) {
+      result = care::host_device_ptr<T>(total, "MergeSorted result");
+      ArrayCopy<T>(exec, result, array, total, 0, first);
+      sortArray(exec, result, total, 0, true);
+      resultLen = uniq ? uniqArray(exec, result, total, true) : total;
+   }
+}
+
+template <typename T>
+CARE_INLINE void MergeSorted(RAJADeviceExec exec, const std::vector<care::host_device_ptr<const T>> & arrays,
+                             const std::vector<int> & lengths,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   int total = 0;
+
+   for (size_t r = 0; r < arrays.size(); ++r) {
+      total += lengths[r] > 0 ? lengths[r] : 0;
+   }
+
+   result = nullptr;
+   resultLen = 0;
+
+   if (total > 0) {
+      result = care::host_device_ptr<T>(total, "MergeSorted result");
+
+      int offset = 0;
+
+      for (size_t r = 0; r < arrays.size(); ++r) {
+         if (lengths[r] > 0) {
+            ArrayCopy<T>(exec, result, arrays[r], lengths[r], offset, 0);
+            offset += lengths[r];
+         }
+      }
+
+      sortArray(exec, result, total, 0, true);
+      resultLen = uniq ? uniqArray(exec, result, total, true) : total;
+   }
+}
+
+#else // defined(CARE_GPUCC)
+
+/************************************************************************
+ * Function  : MergeSorted
+ * Purpose   : OpenMP version of MergeSorted. The result is split into equal
+ *             pieces by a multiway co-rank search and each thread merges
+ *             its piece with a loser tree (see care::detail::multiwayMerge).
+  ************************************************************************/
+template <typename T>
+CARE_INLINE void MergeSorted(RAJADeviceExec, care::host_device_ptr<const T> array,
+                             care::host_device_ptr<int const> offsets, int numSegments,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   care::detail::MergeSortedSegments(array, offsets, numSegments, result, resultLen, uniq, true);
+}
+
+template <typename T>
+CARE_INLINE void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const T>> & arrays,
+                             const std::vector<int> & lengths,
+                             care::host_device_ptr<T> & result, int & resultLen, bool uniq)
+{
+   care::detail::MergeSortedArrays(arrays, lengths, result, resultLen, uniq, true);
 }
 
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
 /************************************************************************
 * Function  : sort_uniq(<T>_ptr)
 * Author(s) : Peter Robinson
@@ -785,6 +2366,9 @@ CARE_INLINE void sort_uniq(Exec e, care::host_device_ptr<T> * array, int * len,
 *             and only if listType == removed_list is true.
 **************************************************************************/
 #ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
 template <typename T>
 CARE_INLINE void CompressArray(RAJADeviceExec exec, care::host_device_ptr<T> & arr, const int arrLen,
                                care::host_device_ptr<int const> list, const int listLen,
@@ -828,6 +2412,55 @@ CARE_INLINE void CompressArray(RAJADeviceExec exec, care::host_device_ptr<T> & a
    }
 }
 
+#else // defined(CARE_GPUCC)
+
+/************************************************************************
+* Function  : CompressArray<T>
+* Purpose   : OpenMP version of CompressArray. A removed_list is applied by
+*             compacting arr in place (see care::detail::compactInPlace),
+*             with no temporary. A mapping_list is gathered into a temporary
+*             the size of the compressed array, since the gather cannot be
+*             done in place in parallel.
+**************************************************************************/
+template <typename T>
+CARE_INLINE void CompressArray(RAJADeviceExec exec, care::host_device_ptr<T> & arr, const int arrLen,
+                               care::host_device_ptr<int const> list, const int listLen,
+                               const care::compress_array listType, bool realloc)
+{
+   if (listType == care::compress_array::removed_list) {
+      CHAIDataGetter<T, RAJA::seq_exec> getter {};
+      auto * rawData = getter.getRawArrayData(arr);
+      const care::detail::notInSortedList keep {care::host_ptr<int const>(list).cdata(), listLen};
+      const int numKept = (int) care::detail::compactInPlace(rawData, (size_t) arrLen, keep, true);
+
+#ifdef CARE_DEBUG
+      int numRemoved = arrLen - numKept;
+      if (listLen != numRemoved) {
+         printf("Warning in CompressArray<T>: did not remove expected number of members!\n");
+      }
+#endif
+      if (realloc) {
+         arr.realloc(numKept) ;
+      }
+   }
+   else {
+      care::host_device_ptr<T> tmp(listLen, "CompressArray tmp");
+      CARE_STREAM_LOOP(newIndex, 0, listLen) {
+         tmp[newIndex] = arr[list[newIndex]] ;
+      } CARE_STREAM_LOOP_END
+      if (realloc) {
+         arr.free();
+         arr = tmp;
+      }
+      else {
+         ArrayCopy<T>(exec, arr, tmp, listLen);
+         tmp.free();
+      }
+   }
+}
+
+#endif // defined(CARE_GPUCC)
+
 #endif // defined(CARE_PARALLEL_DEVICE)
 
 /************************************************************************
@@ -1416,6 +3049,524 @@ CARE_INLINE T ArrayMaskedSum(care::host_device_ptr<const T> arr,
    return (T) (ReduceType) sum ;
 }
 
+/************************************************************************
+ * Function  : ArrayStats
+ * Purpose   : Returns the min, max, sum and count of the first n values in
+ *             arr, along with the index of the min and max, all
+ *             computed in a single pass.
+ * ************************************************************************/
+template <typename T, typename ReduceType, typename Exec>
+CARE_INLINE ArrayStatistics<T, ReduceType> ArrayStats(care::host_device_ptr<const T> arr, int n)
+{
+   RAJAReduceMinLoc<T> min { std::numeric_limits<T>::max(), -1 };
+   RAJAReduceMaxLoc<T> max { std::numeric_limits<T>::lowest(), -1 };
+   RAJAReduceSum<ReduceType> sum { (ReduceType) 0 };
+
+   CARE_REDUCE_LOOP(k, 0, n) {
+      const T val = arr[k];
+      min.minloc(val, k);
+      max.maxloc(val, k);
+      sum += val;
+   } CARE_REDUCE_LOOP_END
+
+   ArrayStatistics<T, ReduceType> stats;
+   stats.min = (T) min;
+   stats.max = (T) max;
+   stats.sum = (ReduceType) sum;
+   stats.count = n > 0 ? n : 0;
+   stats.minLoc = stats.count > 0 ? (int) min.getLoc() : -1;
+   stats.maxLoc = stats.count > 0 ? (int) max.getLoc() : -1;
+   return stats;
+}
+
+/************************************************************************
+ * Function  : ArrayStatsSubset
+ * Purpose   : Returns the min, max, sum and count of the values in arr at
+ *             the indices in subset, computed in a single pass. minLoc and
+ *             maxLoc are indices into arr, not into subset.
+ * Note      : length n refers to length of subset, not array
+ * ************************************************************************/
+template <typename T, typename ReduceType, typename Exec>
+CARE_INLINE ArrayStatistics<T, ReduceType> ArrayStatsSubset(care::host_device_ptr<const T> arr,
+                                                            care::host_device_ptr<int const> subset,
+                                                            int n)
+{
+   RAJAReduceMinLoc<T> min { std::numeric_limits<T>::max(), -1 };
+   RAJAReduceMaxLoc<T> max { std::numeric_limits<T>::lowest(), -1 };
+   RAJAReduceSum<ReduceType> sum { (ReduceType) 0 };
+
+   CARE_REDUCE_LOOP(k, 0, n) {
+      const int ndx = subset[k];
+      const T val = arr[ndx];
+      min.minloc(val, ndx);
+      max.maxloc(val, ndx);
+      sum += val;
+   } CARE_REDUCE_LOOP_END
+
+   ArrayStatistics<T, ReduceType> stats;
+   stats.min = (T) min;
+   stats.max = (T) max;
+   stats.sum = (ReduceType) sum;
+   stats.count = n > 0 ? n : 0;
+   stats.minLoc = stats.count > 0 ? (int) min.getLoc() : -1;
+   stats.maxLoc = stats.count > 0 ? (int) max.getLoc() : -1;
+   return stats;
+}
+
+/************************************************************************
+ * Function  : ArrayMaskedStats
+ * Purpose   : Returns the min, max, sum and count of the values in arr at
+ *             indices where mask is 0 (the same convention as
+ *             ArrayMaskedSum), computed in a single pass.
+ * ************************************************************************/
+template <typename T, typename ReduceType, typename Exec>
+CARE_INLINE ArrayStatistics<T, ReduceType> ArrayMaskedStats(care::host_device_ptr<const T> arr,
+                                                            care::host_device_ptr<int const> mask,
+                                                            int n)
+{
+   RAJAReduceMinLoc<T> min { std::numeric_limits<T>::max(), -1 };
+   RAJAReduceMaxLoc<T> max { std::numeric_limits<T>::lowest(), -1 };
+   RAJAReduceSum<ReduceType> sum { (ReduceType) 0 };
+   RAJAReduceSum<int> count { 0 };
+
+   CARE_REDUCE_LOOP(k, 0, n) {
+      if (mask[k] == 0) {
+         const T val = arr[k];
+         min.minloc(val, k);
+         max.maxloc(val, k);
+         sum += val;
+         count += 1;
+      }
+   } CARE_REDUCE_LOOP_END
+
+   ArrayStatistics<T, ReduceType> stats;
+   stats.min = (T) min;
+   stats.max = (T) max;
+   stats.sum = (ReduceType) sum;
+   stats.count = (int) count;
+   stats.minLoc = stats.count > 0 ? (int) min.getLoc() : -1;
+   stats.maxLoc = stats.count > 0 ? (int) max.getLoc() : -1;
+   return stats;
+}
+
+/************************************************************************
+ * Function  : ArrayMaskedStatsSubset
+ * Purpose   : Returns the min, max, sum and count of the values in arr at
+ *             the indices in subset where mask is 0 (the same convention
+ *             as ArrayMaskedSumSubset), computed in a single pass. minLoc
+ *             and maxLoc are indices into arr, not into subset.
+ * Note      : length n refers to length of subset, not array
+ * ************************************************************************/
+template <typename T, typename ReduceType, typename Exec>
+CARE_INLINE ArrayStatistics<T, ReduceType> ArrayMaskedStatsSubset(care::host_device_ptr<const T> arr,
+                                                                  care::host_device_ptr<int const> mask,
+                                                                  care::host_device_ptr<int const> subset,
+                                                                  int n)
+{
+   RAJAReduceMinLoc<T> min { std::numeric_limits<T>::max(), -1 };
+   RAJAReduceMaxLoc<T> max { std::numeric_limits<T>::lowest(), -1 };
+   RAJAReduceSum<ReduceType> sum { (ReduceType) 0 };
+   RAJAReduceSum<int> count { 0 };
+
+   CARE_REDUCE_LOOP(k, 0, n) {
+      const int ndx = subset[k];
+
+      if (mask[ndx] == 0) {
+         const T val = arr[ndx];
+         min.minloc(val, ndx);
+         max.maxloc(val, ndx);
+         sum += val;
+         count += 1;
+      }
+   } CARE_REDUCE_LOOP_END
+
+   ArrayStatistics<T, ReduceType> stats;
+   stats.min = (T) min;
+   stats.max = (T) max;
+   stats.sum = (ReduceType) sum;
+   stats.count = (int) count;
+   stats.minLoc = stats.count > 0 ? (int) min.getLoc() : -1;
+   stats.maxLoc = stats.count > 0 ? (int) max.getLoc() : -1;
+   return stats;
+}
+
+namespace detail {
+
+/************************************************************************
+ * The operations used by SegmentedReduce. lift turns the element at
+ * index i into a partial result and combine merges two partial results,
+ * where the left one always comes from earlier in the segment.
+ * ************************************************************************/
+template <typename T, typename ReduceType>
+struct SegmentedSumOp {
+   CARE_HOST_DEVICE static ReduceType lift(const care::host_device_ptr<const T>& values, int i) {
+      return (ReduceType) values[i];
+   }
+
+   CARE_HOST_DEVICE static ReduceType combine(const care::host_device_ptr<const T>&, ReduceType left, ReduceType right) {
+      return left + right;
+   }
+};
+
+template <typename T>
+struct SegmentedMinOp {
+   CARE_HOST_DEVICE static T lift(const care::host_device_ptr<const T>& values, int i) {
+      return values[i];
+   }
+
+   CARE_HOST_DEVICE static T combine(const care::host_device_ptr<const T>&, T left, T right) {
+      return right < left ? right : left;
+   }
+};
+
+template <typename T>
+struct SegmentedMaxOp {
+   CARE_HOST_DEVICE static T lift(const care::host_device_ptr<const T>& values, int i) {
+      return values[i];
+   }
+
+   CARE_HOST_DEVICE static T combine(const care::host_device_ptr<const T>&, T left, T right) {
+      return left < right ? right : left;
+   }
+};
+
+template <typename T>
+struct SegmentedArgMinOp {
+   CARE_HOST_DEVICE static int lift(const care::host_device_ptr<const T>&, int i) {
+      return i;
+   }
+
+   CARE_HOST_DEVICE static int combine(const care::host_device_ptr<const T>& values, int left, int right) {
+      return values[right] < values[left] ? right : left;
+   }
+};
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : SegmentedSum
+ * Purpose   : Sums each segment of values described by offsets.
+ * ************************************************************************/
+template <typename T, typename ReduceType, typename Exec>
+CARE_INLINE void SegmentedSum(care::host_device_ptr<const T> values,
+                              care::host_device_ptr<int const> offsets,
+                              int numSegments,
+                              care::host_device_ptr<ReduceType> sums)
+{
+   detail::SegmentedReduce<detail::SegmentedSumOp<T, ReduceType>>(Exec{}, values, offsets, numSegments,
+                                                                  sums, (ReduceType) 0);
+}
+
+/************************************************************************
+ * Function  : SegmentedMin
+ * Purpose   : Finds the minimum of each segment of values described by
+ *             offsets.
+ * ************************************************************************/
+template <typename T, typename Exec>
+CARE_INLINE void SegmentedMin(care::host_device_ptr<const T> values,
+                              care::host_device_ptr<int const> offsets,
+                              int numSegments,
+                              care::host_device_ptr<T> mins)
+{
+   detail::SegmentedReduce<detail::SegmentedMinOp<T>>(Exec{}, values, offsets, numSegments,
+                                                      mins, std::numeric_limits<T>::max());
+}
+
+/************************************************************************
+ * Function  : SegmentedMax
+ * Purpose   : Finds the maximum of each segment of values described by
+ *             offsets.
+ * ************************************************************************/
+template <typename T, typename Exec>
+CARE_INLINE void SegmentedMax(care::host_device_ptr<const T> values,
+                              care::host_device_ptr<int const> offsets,
+                              int numSegments,
+                              care::host_device_ptr<T> maxs)
+{
+   detail::SegmentedReduce<detail::SegmentedMaxOp<T>>(Exec{}, values, offsets, numSegments,
+                                                      maxs, std::numeric_limits<T>::lowest());
+}
+
+/************************************************************************
+ * Function  : SegmentedArgMin
+ * Purpose   : Finds the index into values of the first minimum of each
+ *             segment of values described by offsets.
+ * ************************************************************************/
+template <typename T, typename Exec>
+CARE_INLINE void SegmentedArgMin(care::host_device_ptr<const T> values,
+                                 care::host_device_ptr<int const> offsets,
+                                 int numSegments,
+                                 care::host_device_ptr<int> locs)
+{
+   detail::SegmentedReduce<detail::SegmentedArgMinOp<T>>(Exec{}, values, offsets, numSegments,
+                                                         locs, -1);
+}
+
+namespace detail {
+
+/************************************************************************
+ * The bins used by Histogram and BinCount. Each returns the bin of a
+ * value, or -1 if the value is not counted.
+  ************************************************************************/
+template <typename T>
+struct HistogramBin {
+   T lo;
+   T hi;
+   double scale;
+   int nbins;
+
+   CARE_HOST_DEVICE int operator()(const T value) const {
+      if (!(lo <= value && value < hi)) {
+         return -1;
+      }
+
+      // Rounding can put values just below hi past the last bin
+      const int bin = (int) (((double) value - (double) lo) * scale);
+      return bin < nbins ? bin : nbins - 1;
+   }
+};
+
+struct KeyBin {
+   int nbins;
+
+   CARE_HOST_DEVICE int operator()(const int key) const {
+      return 0 <= key && key < nbins ? key : -1;
+   }
+};
+
+/************************************************************************
+ * Adapts a bin to care::detail::binCount, which bins by index
+  ************************************************************************/
+template <typename T, typename Bin>
+struct HostBinOf {
+   const T * values;
+   Bin bin;
+
+   int operator()(const size_t i) const {
+      return bin(values[i]);
+   }
+};
+
+/************************************************************************
+ * Function  : CountBins
+ * Purpose   : CPU version of the counting done by Histogram and BinCount
+ *             (see care::detail::binCount).
+  ************************************************************************/
+template <typename T, typename Bin>
+CARE_INLINE void CountBins(RAJA::seq_exec, care::host_device_ptr<const T> values, int n,
+                           int nbins, Bin bin, care::host_device_ptr<int> counts)
+{
+   const T * hostValues = n > 0 ? care::host_ptr<const T>(values).cdata() : nullptr;
+   binCount((size_t) (n > 0 ? n : 0), nbins, HostBinOf<T, Bin>{hostValues, bin},
+            care::host_ptr<int>(counts).data(), false);
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+/************************************************************************
+ * The most bins that are counted in shared memory on the device, which
+ * keeps the histogram of each block at 16 KB
+  ************************************************************************/
+constexpr int histogramMaxSharedBins = 4096;
+
+/************************************************************************
+ * Function  : countBinsKernel
+ * Purpose   : Each block counts its values, one per thread, into a
+ *             histogram in shared memory, then adds the nonzero bins to
+ *             counts with one atomic per bin.
+  ************************************************************************/
+template <typename T, typename Bin>
+CARE_GLOBAL void countBinsKernel(const T * values, int n, int nbins, Bin bin, int * counts)
+{
+   extern __shared__ int blockCounts[];
+
+   for (int b = threadIdx.x; b < nbins; b += blockDim.x) {
+      blockCounts[b] = 0;
+   }
+
+   __syncthreads();
+
+   const int i = blockDim.x * blockIdx.x + threadIdx.x;
+
+   if (i < n) {
+      const int valueBin = bin(values[i]);
+
+      if (valueBin >= 0) {
+         atomicAdd(&blockCounts[valueBin], 1);
+      }
+   }
+
+   __syncthreads();
+
+   for (int b = threadIdx.x; b < nbins; b += blockDim.x) {
+      if (blockCounts[b] > 0) {
+         atomicAdd(&counts[b], blockCounts[b]);
+      }
+   }
+}
+
+/************************************************************************
+ * Function  : CountBins
+ * Purpose   : GPU version of the counting done by Histogram and
+ *             BinCount. With up to histogramMaxSharedBins bins, each
+ *             block privatizes the bins in shared memory (see
+ *             countBinsKernel), so the global atomics are up to a block
+ *             size times less contended. With more bins, contention is
+ *             low and each value is added to counts with an atomic.
+  ************************************************************************/
+template <typename T, typename Bin>
+CARE_INLINE void CountBins(RAJADeviceExec, care::host_device_ptr<const T> values, int n,
+                           int nbins, Bin bin, care::host_device_ptr<int> counts)
+{
+   CARE_STREAM_LOOP(b, 0, nbins) {
+      counts[b] = 0;
+   } CARE_STREAM_LOOP_END
+
+   if (n <= 0) {
+      return;
+   }
+
+   if (nbins <= histogramMaxSharedBins) {
+      CHAIDataGetter<T, RAJADeviceExec> getter {};
+      CHAIDataGetter<int, RAJADeviceExec> intGetter {};
+
+      care::host_device_ptr<T> mutableValues = *reinterpret_cast<care::host_device_ptr<T> *>(&values);
+
+      const T * rawValues = getter.getRawArrayData(mutableValues);
+      int * rawCounts = intGetter.getRawArrayData(counts);
+
+      const int blockSize = CARE_CUDA_BLOCK_SIZE;
+      const int gridSize = (n + blockSize - 1) / blockSize;
+
+      countBinsKernel<<<gridSize, blockSize, nbins * sizeof(int)>>>(rawValues, n, nbins, bin, rawCounts);
+
+#if FORCE_SYNC
+      care::gpuDeviceSynchronize(__FILE__, __LINE__);
+#endif
+   }
+   else {
+      CARE_STREAM_LOOP(i, 0, n) {
+         const int valueBin = bin(values[i]);
+
+         if (valueBin >= 0) {
+            ATOMIC_ADD(counts[valueBin], 1);
+         }
+      } CARE_STREAM_LOOP_END
+   }
+}
+
+#else // defined(CARE_GPUCC)
+
+/************************************************************************
+ * Function  : CountBins
+ * Purpose   : OpenMP version of the counting done by Histogram and
+ *             BinCount, with private bins per thread (see
+ *             care::detail::binCount).
+  ************************************************************************/
+template <typename T, typename Bin>
+CARE_INLINE void CountBins(RAJADeviceExec, care::host_device_ptr<const T> values, int n,
+                           int nbins, Bin bin, care::host_device_ptr<int> counts)
+{
+   const T * hostValues = n > 0 ? care::host_ptr<const T>(values).cdata() : nullptr;
+   binCount((size_t) (n > 0 ? n : 0), nbins, HostBinOf<T, Bin>{hostValues, bin},
+            care::host_ptr<int>(counts).data(), true);
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+/************************************************************************
+ * Function  : BinOffsets
+ * Purpose   : Writes the exclusive scan of counts to offsets, followed by
+ *             the total, if offsets is given.
+  ************************************************************************/
+template <typename Exec>
+CARE_INLINE void BinOffsets(Exec, care::host_device_ptr<const int> counts, int nbins,
+                            care::host_device_ptr<int> offsets)
+{
+   if (offsets) {
+      CARE_LOOP(Exec{}, b, 0, nbins + 1) {
+         offsets[b] = b < nbins ? counts[b] : 0;
+      } CARE_LOOP_END
+
+      care::exclusive_scan(Exec{}, offsets, nullptr, nbins + 1, 0, true);
+   }
+}
+
+} // namespace detail
+
+/************************************************************************
+ * Function  : Histogram
+ * Purpose   : Counts the values in each of nbins equal bins of [lo, hi).
+  ************************************************************************/
+template <typename T, typename Exec>
+CARE_INLINE void Histogram(care::host_device_ptr<const T> values, int n, int nbins, T lo, T hi,
+                           care::host_device_ptr<int> counts, care::host_device_ptr<int> offsets)
+{
+   if (nbins <= 0) {
+      return;
+   }
+
+   const double scale = lo < hi ? nbins / ((double) hi - (double) lo) : 0.0;
+   const detail::HistogramBin<T> bin {lo, hi, scale, nbins};
+
+   detail::CountBins(Exec{}, values, n, nbins, bin, counts);
+   detail::BinOffsets(Exec{}, counts, nbins, offsets);
+}
+
+/************************************************************************
+ * Function  : BinCount
+ * Purpose   : Counts the keys equal to each of 0 to nbins-1.
+  ************************************************************************/
+template <typename Exec>
+CARE_INLINE void BinCount(care::host_device_ptr<const int> keys, int n, int nbins,
+                          care::host_device_ptr<int> counts, care::host_device_ptr<int> offsets)
+{
+   if (nbins <= 0) {
+      return;
+   }
+
+   detail::CountBins(Exec{}, keys, n, nbins, detail::KeyBin{nbins}, counts);
+   detail::BinOffsets(Exec{}, counts, nbins, offsets);
+}
+
+/************************************************************************
+ * Function  : ExclusiveScan
+ * Purpose   : Writes op(init, in[0], ..., in[i-1]) to out[i] (see
+ *             care::exclusive_scan).
+ ************************************************************************/
+template <typename T, typename Exec, typename BinaryOp>
+CARE_INLINE void ExclusiveScan(care::host_device_ptr<const T> in, care::host_device_ptr<T> out, int n,
+                               BinaryOp op, T init)
+{
+   if (n > 0) {
+      chai::ManagedArray<T> data = *reinterpret_cast<chai::ManagedArray<T> *>(&in);
+      CHAIDataGetter<T, Exec> getter {};
+      const bool inPlace = getter.getRawArrayData(data) == getter.getRawArrayData(out);
+      care::exclusive_scan<T, Exec>(data, out, n, op, init, inPlace);
+   }
+}
+
+/************************************************************************
+ * Function  : InclusiveScan
+ * Purpose   : Writes op(in[0], ..., in[i]) to out[i] (see
+ *             care::inclusive_scan).
+ ************************************************************************/
+template <typename T, typename Exec, typename BinaryOp>
+CARE_INLINE void InclusiveScan(care::host_device_ptr<const T> in, care::host_device_ptr<T> out, int n,
+                               BinaryOp op)
+{
+   if (n > 0) {
+      chai::ManagedArray<T> data = *reinterpret_cast<chai::ManagedArray<T> *>(&in);
+      CHAIDataGetter<T, Exec> getter {};
+      const bool inPlace = getter.getRawArrayData(data) == getter.getRawArrayData(out);
+      care::inclusive_scan<T, Exec>(data, out, n, op, inPlace);
+   }
+}
+
 /************************************************************************
  * Function  : FindIndexGT
  * Author(s) : Peter Robinson
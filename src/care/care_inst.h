@@ -154,6 +154,96 @@ void IntersectArrays(RAJA::seq_exec, care::host_device_ptr<globalID>, int, int,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJADeviceExec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJADeviceExec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJADeviceExec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJADeviceExec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJADeviceExec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJADeviceExec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJADeviceExec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJADeviceExec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJADeviceExec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJADeviceExec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJADeviceExec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJADeviceExec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJA::seq_exec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJA::seq_exec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJA::seq_exec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void UnionArrays(RAJA::seq_exec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJA::seq_exec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJA::seq_exec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJA::seq_exec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void DifferenceArrays(RAJA::seq_exec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJA::seq_exec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJA::seq_exec, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<const globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJA::seq_exec, care::host_device_ptr<int>, int, int, care::host_device_ptr<int>, int, int, care::host_device_ptr<int> &, int *) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void SymmetricDifferenceArrays(RAJA::seq_exec, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID>, int, int, care::host_device_ptr<globalID> &, int *) ;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
 CARE_EXTERN template CARE_DLL_API
 CARE_HOST_DEVICE int BinarySearch(const int *, const int, const int, const int, bool) ;
 CARE_EXTERN template CARE_DLL_API
@@ -201,6 +291,47 @@ CARE_HOST_DEVICE int BinarySearch(const care::host_device_ptr<const GIDTYPE>&, c
 
 ///////////////////////////////////////////////////////////////////////////////
 
+CARE_EXTERN template CARE_DLL_API
+CARE_HOST_DEVICE int BranchlessBinarySearch(const int *, const int, const int, const int, bool) ;
+CARE_EXTERN template CARE_DLL_API
+CARE_HOST_DEVICE int BranchlessBinarySearch(const size_t *, const int, const int, const size_t, bool) ;
+#if CARE_HAVE_LLNL_GLOBALID
+
+CARE_EXTERN template CARE_DLL_API
+CARE_HOST_DEVICE int BranchlessBinarySearch(const globalID *, const int, const int, const globalID, bool) ;
+#if GLOBALID_IS_64BIT
+CARE_EXTERN template CARE_DLL_API
+CARE_HOST_DEVICE int BranchlessBinarySearch(const GIDTYPE *, const int, const int, const GIDTYPE, bool) ;
+#endif
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJADeviceExec, care::host_device_ptr<const int>, const int, const int, care::host_device_ptr<const int>, const int, care::host_device_ptr<int>, bool, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJADeviceExec, care::host_device_ptr<const size_t>, const int, const int, care::host_device_ptr<const size_t>, const int, care::host_device_ptr<int>, bool, bool) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJADeviceExec, care::host_device_ptr<const globalID>, const int, const int, care::host_device_ptr<const globalID>, const int, care::host_device_ptr<int>, bool, bool) ;
+#endif
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJA::seq_exec, care::host_device_ptr<const int>, const int, const int, care::host_device_ptr<const int>, const int, care::host_device_ptr<int>, bool, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJA::seq_exec, care::host_device_ptr<const size_t>, const int, const int, care::host_device_ptr<const size_t>, const int, care::host_device_ptr<int>, bool, bool) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void BinarySearchBatch(RAJA::seq_exec, care::host_device_ptr<const globalID>, const int, const int, care::host_device_ptr<const globalID>, const int, care::host_device_ptr<int>, bool, bool) ;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
 #ifdef CARE_PARALLEL_DEVICE
 
 CARE_EXTERN template CARE_DLL_API
@@ -413,6 +544,50 @@ void sortArray(RAJA::seq_exec, care::host_device_ptr<globalID, care::RaceConditi
 
 #ifdef CARE_PARALLEL_DEVICE
 
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJADeviceExec, care::host_device_ptr<int>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJADeviceExec, care::host_device_ptr<int>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJADeviceExec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, care::host_device_ptr<int> &) ;
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJADeviceExec, care::host_device_ptr<float>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJADeviceExec, care::host_device_ptr<float>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJADeviceExec, care::host_device_ptr<const float>, int, int, care::host_device_ptr<float> &, care::host_device_ptr<int> &) ;
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJADeviceExec, care::host_device_ptr<double>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJADeviceExec, care::host_device_ptr<double>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJADeviceExec, care::host_device_ptr<const double>, int, int, care::host_device_ptr<double> &, care::host_device_ptr<int> &) ;
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJA::seq_exec, care::host_device_ptr<int>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJA::seq_exec, care::host_device_ptr<int>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJA::seq_exec, care::host_device_ptr<const int>, int, int, care::host_device_ptr<int> &, care::host_device_ptr<int> &) ;
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJA::seq_exec, care::host_device_ptr<float>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJA::seq_exec, care::host_device_ptr<float>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJA::seq_exec, care::host_device_ptr<const float>, int, int, care::host_device_ptr<float> &, care::host_device_ptr<int> &) ;
+CARE_EXTERN template CARE_DLL_API
+void NthElement(RAJA::seq_exec, care::host_device_ptr<double>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void PartialSort(RAJA::seq_exec, care::host_device_ptr<double>, int, int) ;
+CARE_EXTERN template CARE_DLL_API
+void TopK(RAJA::seq_exec, care::host_device_ptr<const double>, int, int, care::host_device_ptr<double> &, care::host_device_ptr<int> &) ;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
 CARE_EXTERN template CARE_DLL_API
 void sort_uniq(RAJADeviceExec, care::host_device_ptr<int> *, int *, bool) ;
 CARE_EXTERN template CARE_DLL_API
@@ -441,6 +616,94 @@ void sort_uniq(RAJA::seq_exec, care::host_device_ptr<globalID> *, int *, bool) ;
 
 #ifdef CARE_PARALLEL_DEVICE
 
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJADeviceExec, care::host_device_ptr<int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJADeviceExec, care::host_device_ptr<float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJADeviceExec, care::host_device_ptr<double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJA::seq_exec, care::host_device_ptr<int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJA::seq_exec, care::host_device_ptr<float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void sortSegments(RAJA::seq_exec, care::host_device_ptr<double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJADeviceExec, care::host_device_ptr<int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJADeviceExec, care::host_device_ptr<float>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJADeviceExec, care::host_device_ptr<double>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJA::seq_exec, care::host_device_ptr<int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJA::seq_exec, care::host_device_ptr<float>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void uniqSegments(RAJA::seq_exec, care::host_device_ptr<double>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const int>> &, const std::vector<int> &, care::host_device_ptr<int> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const float>> &, const std::vector<int> &, care::host_device_ptr<float> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const double>> &, const std::vector<int> &, care::host_device_ptr<double> &, int &, bool) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, care::host_device_ptr<const globalID>, care::host_device_ptr<int const>, int, care::host_device_ptr<globalID> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJADeviceExec, const std::vector<care::host_device_ptr<const globalID>> &, const std::vector<int> &, care::host_device_ptr<globalID> &, int &, bool) ;
+#endif
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const int>> &, const std::vector<int> &, care::host_device_ptr<int> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const float>> &, const std::vector<int> &, care::host_device_ptr<float> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const double>> &, const std::vector<int> &, care::host_device_ptr<double> &, int &, bool) ;
+#if CARE_HAVE_LLNL_GLOBALID
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, care::host_device_ptr<const globalID>, care::host_device_ptr<int const>, int, care::host_device_ptr<globalID> &, int &, bool) ;
+CARE_EXTERN template CARE_DLL_API
+void MergeSorted(RAJA::seq_exec, const std::vector<care::host_device_ptr<const globalID>> &, const std::vector<int> &, care::host_device_ptr<globalID> &, int &, bool) ;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
 CARE_EXTERN template CARE_DLL_API
 void CompressArray(RAJADeviceExec, care::host_device_ptr<bool> &, const int, care::host_device_ptr<int const>, const int, const care::compress_array, bool) ;
 CARE_EXTERN template CARE_DLL_API
@@ -1128,6 +1391,310 @@ double ArrayMaskedSumSubset<double, double, RAJA::seq_exec>(care::host_device_pt
 
 #ifdef CARE_PARALLEL_DEVICE
 
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayStats<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayStats<float, float, RAJADeviceExec>(care::host_device_ptr<const float>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayStats<double, double, RAJADeviceExec>(care::host_device_ptr<const double>, int) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayStats<int, int, RAJA::seq_exec>(care::host_device_ptr<const int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayStats<float, float, RAJA::seq_exec>(care::host_device_ptr<const float>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayStats<double, double, RAJA::seq_exec>(care::host_device_ptr<const double>, int) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayStatsSubset<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayStatsSubset<float, float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayStatsSubset<double, double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayStatsSubset<int, int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayStatsSubset<float, float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayStatsSubset<double, double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayMaskedStats<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayMaskedStats<float, float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayMaskedStats<double, double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayMaskedStats<int, int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayMaskedStats<float, float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayMaskedStats<double, double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayMaskedStatsSubset<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayMaskedStatsSubset<float, float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayMaskedStatsSubset<double, double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<int, int> ArrayMaskedStatsSubset<int, int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<float, float> ArrayMaskedStatsSubset<float, float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+CARE_EXTERN template CARE_DLL_API
+ArrayStatistics<double, double> ArrayMaskedStatsSubset<double, double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, care::host_device_ptr<int const>, int) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<float, float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<double, double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<int, int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<float, float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedSum<double, double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMin<double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedMax<double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<double>) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<float, RAJADeviceExec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<double, RAJADeviceExec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+// TODO GID not implemented
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<int, RAJA::seq_exec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<float, RAJA::seq_exec>(care::host_device_ptr<const float>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void SegmentedArgMin<double, RAJA::seq_exec>(care::host_device_ptr<const double>, care::host_device_ptr<int const>, int, care::host_device_ptr<int>) ;
+// TODO GID not implemented
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void Histogram<int, RAJADeviceExec>(care::host_device_ptr<const int>, int, int, int, int, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void Histogram<float, RAJADeviceExec>(care::host_device_ptr<const float>, int, int, float, float, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void Histogram<double, RAJADeviceExec>(care::host_device_ptr<const double>, int, int, double, double, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void BinCount<RAJADeviceExec>(care::host_device_ptr<const int>, int, int, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void Histogram<int, RAJA::seq_exec>(care::host_device_ptr<const int>, int, int, int, int, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void Histogram<float, RAJA::seq_exec>(care::host_device_ptr<const float>, int, int, float, float, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void Histogram<double, RAJA::seq_exec>(care::host_device_ptr<const double>, int, int, double, double, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void BinCount<RAJA::seq_exec>(care::host_device_ptr<const int>, int, int, care::host_device_ptr<int>, care::host_device_ptr<int>) ;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJADeviceExec, RAJA::operators::plus<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::plus<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJADeviceExec, RAJA::operators::plus<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::plus<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJADeviceExec, RAJA::operators::minimum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::minimum<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJADeviceExec, RAJA::operators::minimum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::minimum<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJADeviceExec, RAJA::operators::maximum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::maximum<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJADeviceExec, RAJA::operators::maximum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::maximum<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJADeviceExec, RAJA::operators::plus<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::plus<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJADeviceExec, RAJA::operators::plus<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::plus<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJADeviceExec, RAJA::operators::minimum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::minimum<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJADeviceExec, RAJA::operators::minimum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::minimum<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJADeviceExec, RAJA::operators::maximum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::maximum<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJADeviceExec, RAJA::operators::maximum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::maximum<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJADeviceExec, RAJA::operators::plus<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::plus<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJADeviceExec, RAJA::operators::plus<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::plus<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJADeviceExec, RAJA::operators::minimum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::minimum<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJADeviceExec, RAJA::operators::minimum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::minimum<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJADeviceExec, RAJA::operators::maximum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::maximum<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJADeviceExec, RAJA::operators::maximum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::maximum<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJADeviceExec, RAJA::operators::plus<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::plus<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJADeviceExec, RAJA::operators::plus<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::plus<double>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJADeviceExec, RAJA::operators::minimum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::minimum<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJADeviceExec, RAJA::operators::minimum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::minimum<double>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJADeviceExec, RAJA::operators::maximum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::maximum<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJADeviceExec, RAJA::operators::maximum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::maximum<double>) ;
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJA::seq_exec, RAJA::operators::plus<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::plus<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJA::seq_exec, RAJA::operators::plus<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::plus<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJA::seq_exec, RAJA::operators::minimum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::minimum<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJA::seq_exec, RAJA::operators::minimum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::minimum<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<int, RAJA::seq_exec, RAJA::operators::maximum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::maximum<int>, int) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<int, RAJA::seq_exec, RAJA::operators::maximum<int>>(care::host_device_ptr<const int>, care::host_device_ptr<int>, int, RAJA::operators::maximum<int>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::plus<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::plus<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::plus<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::plus<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::minimum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::minimum<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::minimum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::minimum<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::maximum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::maximum<size_t>, size_t) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<size_t, RAJA::seq_exec, RAJA::operators::maximum<size_t>>(care::host_device_ptr<const size_t>, care::host_device_ptr<size_t>, int, RAJA::operators::maximum<size_t>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJA::seq_exec, RAJA::operators::plus<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::plus<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJA::seq_exec, RAJA::operators::plus<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::plus<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJA::seq_exec, RAJA::operators::minimum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::minimum<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJA::seq_exec, RAJA::operators::minimum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::minimum<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<float, RAJA::seq_exec, RAJA::operators::maximum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::maximum<float>, float) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<float, RAJA::seq_exec, RAJA::operators::maximum<float>>(care::host_device_ptr<const float>, care::host_device_ptr<float>, int, RAJA::operators::maximum<float>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJA::seq_exec, RAJA::operators::plus<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::plus<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJA::seq_exec, RAJA::operators::plus<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::plus<double>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJA::seq_exec, RAJA::operators::minimum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::minimum<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJA::seq_exec, RAJA::operators::minimum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::minimum<double>) ;
+CARE_EXTERN template CARE_DLL_API
+void ExclusiveScan<double, RAJA::seq_exec, RAJA::operators::maximum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::maximum<double>, double) ;
+CARE_EXTERN template CARE_DLL_API
+void InclusiveScan<double, RAJA::seq_exec, RAJA::operators::maximum<double>>(care::host_device_ptr<const double>, care::host_device_ptr<double>, int, RAJA::operators::maximum<double>) ;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CARE_PARALLEL_DEVICE
+
 CARE_EXTERN template CARE_DLL_API
 int ArrayMaskedSum<int, int, RAJADeviceExec>(care::host_device_ptr<const int>, care::host_device_ptr<int const>, int, int) ;
 CARE_EXTERN template CARE_DLL_API
@@ -0,0 +1,1978 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_HOST_ALGORITHM_H_
+#define _CARE_HOST_ALGORITHM_H_
+
+// This header contains raw pointer building blocks used by the host (sequential
+// and OpenMP) implementations of the CARE algorithms. They operate on host
+// memory only and are not meant to be called from within CARE loops.
+
+// CARE headers
+#include "care/config.h"
+#include "care/openmp.h"
+#include "care/sorting_network.h"
+
+// Std library headers
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#if defined(_OPENMP) && defined(RAJA_ENABLE_OPENMP)
+#define CARE_HOST_OPENMP 1
+#define CARE_HOST_PARALLEL_FOR CARE_PRAGMA(omp parallel for schedule(static))
+#define CARE_HOST_PARALLEL_FOR_IF(COND) CARE_PRAGMA(omp parallel for schedule(static) if(COND))
+#define CARE_HOST_PARALLEL_FOR_DYNAMIC_IF(COND) CARE_PRAGMA(omp parallel for schedule(dynamic, 16) if(COND))
+#else
+#define CARE_HOST_OPENMP 0
+#define CARE_HOST_PARALLEL_FOR
+#define CARE_HOST_PARALLEL_FOR_IF(COND)
+#define CARE_HOST_PARALLEL_FOR_DYNAMIC_IF(COND)
+#endif
+
+namespace care {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////
+/// Below this many elements the host algorithms stay sequential, since the
+/// cost of spinning up a parallel region outweighs the work.
+///////////////////////////////////////////////////////////////////////////
+constexpr size_t hostParallelThreshold = 1 << 15;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Returns the number of threads the host algorithms should use
+///        for a problem of the given size.
+/// @param[in] len - The number of elements to be processed
+/// @return 1 if the work should be done sequentially, otherwise the
+///         number of OpenMP threads available
+///////////////////////////////////////////////////////////////////////////
+inline int hostNumThreads(const size_t len)
+{
+#if CARE_HOST_OPENMP
+   if (len >= hostParallelThreshold && !omp_in_parallel()) {
+      return omp_get_max_threads();
+   }
+#endif
+   (void) len;
+   return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Merge path (co-rank) search. Finds the split of the first diag
+///        elements of the stable merge of a and b between the two inputs.
+///        Ties are taken from a first, matching std::merge.
+/// @param[in] a    - The first sorted array
+/// @param[in] aLen - The length of a
+/// @param[in] b    - The second sorted array
+/// @param[in] bLen - The length of b
+/// @param[in] diag - The number of merged elements (0 <= diag <= aLen + bLen)
+/// @param[in] comp - The strict weak ordering used to sort a and b
+/// @return The number of elements taken from a. diag minus this value
+///         elements are taken from b.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Compare>
+inline size_t mergePathSearch(const T* a, const size_t aLen,
+                              const T* b, const size_t bLen,
+                              const size_t diag, Compare comp)
+{
+   size_t low = diag > bLen ? diag - bLen : 0;
+   size_t high = diag < aLen ? diag : aLen;
+
+   while (low < high) {
+      const size_t mid = low + (high - low) / 2;
+
+      if (comp(b[diag - 1 - mid], a[mid])) {
+         high = mid;
+      }
+      else {
+         low = mid + 1;
+      }
+   }
+
+   return low;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable merge of two sorted ranges into out. When OpenMP is
+///        available the output is split into equal pieces with a merge
+///        path search so every thread merges the same number of elements.
+/// @param[in]  a    - The first sorted array
+/// @param[in]  aLen - The length of a
+/// @param[in]  b    - The second sorted array
+/// @param[in]  bLen - The length of b
+/// @param[out] out  - Storage for aLen + bLen elements. Must not alias a or b.
+/// @param[in]  comp - The strict weak ordering used to sort a and b
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Compare>
+inline void parallelMerge(const T* a, const size_t aLen,
+                          const T* b, const size_t bLen,
+                          T* out, Compare comp)
+{
+   const size_t total = aLen + bLen;
+   const int numThreads = hostNumThreads(total);
+
+   if (numThreads > 1) {
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         const size_t d0 = total * t / numThreads;
+         const size_t d1 = total * (t + 1) / numThreads;
+         const size_t a0 = mergePathSearch(a, aLen, b, bLen, d0, comp);
+         const size_t a1 = mergePathSearch(a, aLen, b, bLen, d1, comp);
+
+         std::merge(a + a0, a + a1, b + (d0 - a0), b + (d1 - a1), out + d0, comp);
+      }
+   }
+   else {
+      std::merge(a, a + aLen, b, b + bLen, out, comp);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Copies len elements from src to dst, using all threads for
+///        large arrays.
+/// @param[in]  src - The source array
+/// @param[in]  len - The number of elements to copy
+/// @param[out] dst - The destination array. Must not alias src.
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void parallelCopy(const T* src, const size_t len, T* dst)
+{
+   const int numThreads = hostNumThreads(len);
+
+   if (numThreads > 1) {
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         const size_t begin = len * t / numThreads;
+         const size_t end = len * (t + 1) / numThreads;
+         std::copy(src + begin, src + end, dst + begin);
+      }
+   }
+   else {
+      std::copy(src, src + len, dst);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Host parallel merge sort. Each thread sorts an equal sized run,
+///        then the runs are merged pairwise with parallelMerge until one
+///        run is left. Falls back to std::sort / std::stable_sort for small
+///        arrays or when OpenMP is not available.
+/// @param[in,out] data   - The array to sort
+/// @param[in]     len    - The number of elements to sort
+/// @param[in]     comp   - The strict weak ordering to sort by
+/// @param[in]     stable - Whether equal elements must keep their order
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Compare>
+inline void parallelSort(T* data, const size_t len, Compare comp, const bool stable = false)
+{
+   const int numThreads = hostNumThreads(len);
+
+   if (numThreads <= 1) {
+      if (stable) {
+         std::stable_sort(data, data + len, comp);
+      }
+      else {
+         std::sort(data, data + len, comp);
+      }
+
+      return;
+   }
+
+   std::vector<size_t> bounds(numThreads + 1);
+
+   for (int t = 0; t <= numThreads; ++t) {
+      bounds[t] = len * t / numThreads;
+   }
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      if (stable) {
+         std::stable_sort(data + bounds[t], data + bounds[t + 1], comp);
+      }
+      else {
+         std::sort(data + bounds[t], data + bounds[t + 1], comp);
+      }
+   }
+
+   std::vector<T> scratch(len);
+   T* src = data;
+   T* dst = scratch.data();
+
+   for (size_t numRuns = numThreads; numRuns > 1; numRuns = (numRuns + 1) / 2) {
+      size_t run = 0;
+
+      for (; run + 1 < numRuns; run += 2) {
+         const size_t begin = bounds[run];
+         const size_t middle = bounds[run + 1];
+         const size_t end = bounds[run + 2];
+
+         parallelMerge(src + begin, middle - begin,
+                       src + middle, end - middle,
+                       dst + begin, comp);
+      }
+
+      // An odd run out is carried over to the next pass unchanged
+      if (run < numRuns) {
+         parallelCopy(src + bounds[run], bounds[run + 1] - bounds[run], dst + bounds[run]);
+      }
+
+      // Drop the interior bounds that were merged away
+      size_t numBounds = 0;
+
+      for (size_t i = 0; i <= numRuns; i += 2) {
+         bounds[numBounds++] = bounds[i];
+      }
+
+      if (bounds[numBounds - 1] != len) {
+         bounds[numBounds++] = len;
+      }
+
+      std::swap(src, dst);
+   }
+
+   if (src != data) {
+      parallelCopy(src, len, data);
+   }
+}
+
+template <typename T>
+inline void parallelSort(T* data, const size_t len)
+{
+   parallelSort(data, len, std::less<T>{}, false);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Below this many elements hostSort uses a comparison sort, since the
+/// radix sort has a fixed cost per digit pass.
+///////////////////////////////////////////////////////////////////////////
+constexpr size_t radixSortThreshold = 1 << 11;
+
+///////////////////////////////////////////////////////////////////////////
+/// The number of bits sorted per pass of radixSort
+///////////////////////////////////////////////////////////////////////////
+constexpr int radixDigitBits = 8;
+
+///////////////////////////////////////////////////////////////////////////
+/// Whether radixSort can sort by keys of type K
+///////////////////////////////////////////////////////////////////////////
+template <typename K>
+struct isRadixSortable : std::integral_constant<bool, std::is_integral<K>::value &&
+                                                      !std::is_same<K, bool>::value> {};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Maps an integer key to an unsigned integer with the same order,
+///        by flipping the sign bit of signed types.
+///////////////////////////////////////////////////////////////////////////
+template <typename K>
+inline typename std::make_unsigned<K>::type radixKey(const K key)
+{
+   typedef typename std::make_unsigned<K>::type U;
+   const U signBit = std::is_signed<K>::value ? (U) ((U) 1 << (sizeof(U) * 8 - 1)) : (U) 0;
+   return (U) key ^ signBit;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable least significant digit radix sort by an integer key.
+///        The keys are rebased on their minimum, so only the digits
+///        needed to cover the span of the keys are sorted: keys known to
+///        lie in a small range take one or two passes, whatever their
+///        width. Passes where every key has the same digit are skipped.
+///        With OpenMP, each thread builds the digit histogram of its own
+///        chunk of the data and then scatters that chunk, so the result
+///        is the same as the sequential sort.
+/// @param[in,out] data     - The array to sort
+/// @param[in]     len      - The number of elements to sort
+/// @param[in]     keyOf    - Returns the integer key of an element
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename KeyOf>
+inline void radixSort(T* data, const size_t len, KeyOf keyOf, const bool parallel)
+{
+   typedef typename std::decay<decltype(keyOf(*data))>::type K;
+   typedef typename std::make_unsigned<K>::type U;
+
+   static_assert(isRadixSortable<K>::value, "radixSort requires integer keys");
+
+   if (len <= 1) {
+      return;
+   }
+
+   const int numBuckets = 1 << radixDigitBits;
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+
+   std::vector<size_t> bounds(numThreads + 1);
+
+   for (int t = 0; t <= numThreads; ++t) {
+      bounds[t] = len * t / numThreads;
+   }
+
+   // Find the span of the keys
+   std::vector<U> mins(numThreads);
+   std::vector<U> maxs(numThreads);
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      U low = radixKey(keyOf(data[bounds[t]]));
+      U high = low;
+
+      for (size_t i = bounds[t] + 1; i < bounds[t + 1]; ++i) {
+         const U key = radixKey(keyOf(data[i]));
+         low = key < low ? key : low;
+         high = key > high ? key : high;
+      }
+
+      mins[t] = low;
+      maxs[t] = high;
+   }
+
+   const U minKey = *std::min_element(mins.begin(), mins.end());
+   const U span = *std::max_element(maxs.begin(), maxs.end()) - minKey;
+
+   int numBits = 0;
+
+   while (numBits < (int) (sizeof(U) * 8) && (span >> numBits) != 0) {
+      ++numBits;
+   }
+
+   std::vector<T> scratch;
+   std::vector<size_t> offsets((size_t) numThreads * numBuckets);
+   T* src = data;
+   T* dst = nullptr;
+
+   for (int shift = 0; shift < numBits; shift += radixDigitBits) {
+      std::fill(offsets.begin(), offsets.end(), 0);
+
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         size_t* counts = &offsets[(size_t) t * numBuckets];
+
+         for (size_t i = bounds[t]; i < bounds[t + 1]; ++i) {
+            ++counts[((radixKey(keyOf(src[i])) - minKey) >> shift) & (numBuckets - 1)];
+         }
+      }
+
+      // Turn the counts into the position where each thread starts writing
+      // each digit: digits in order, and threads in order within a digit.
+      size_t total = 0;
+      bool trivial = false;
+
+      for (int d = 0; d < numBuckets; ++d) {
+         size_t digitCount = 0;
+
+         for (int t = 0; t < numThreads; ++t) {
+            size_t& offset = offsets[(size_t) t * numBuckets + d];
+            const size_t count = offset;
+            offset = total;
+            total += count;
+            digitCount += count;
+         }
+
+         trivial = trivial || digitCount == len;
+      }
+
+      if (trivial) {
+         continue;
+      }
+
+      if (dst == nullptr) {
+         scratch.resize(len);
+         dst = scratch.data();
+      }
+
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         size_t* positions = &offsets[(size_t) t * numBuckets];
+
+         for (size_t i = bounds[t]; i < bounds[t + 1]; ++i) {
+            const int digit = (int) (((radixKey(keyOf(src[i])) - minKey) >> shift) & (numBuckets - 1));
+            dst[positions[digit]++] = src[i];
+         }
+      }
+
+      std::swap(src, dst);
+   }
+
+   if (src != data) {
+      parallelCopy(src, len, data);
+   }
+}
+
+template <typename T>
+struct radixIdentityKey {
+   T operator()(const T& value) const { return value; }
+};
+
+template <typename T>
+inline void radixSort(T* data, const size_t len, const bool parallel)
+{
+   radixSort(data, len, radixIdentityKey<T>{}, parallel);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sorts data in ascending order with the fastest host algorithm
+///        available: radixSort for large arrays of integers, otherwise
+///        parallelSort (or std::sort when parallel is false).
+/// @param[in,out] data     - The array to sort
+/// @param[in]     len      - The number of elements to sort
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void hostSort(T* data, const size_t len, const bool parallel, std::true_type)
+{
+   if (len >= radixSortThreshold) {
+      radixSort(data, len, parallel);
+   }
+   else {
+      std::sort(data, data + len);
+   }
+}
+
+template <typename T>
+inline void hostSort(T* data, const size_t len, const bool parallel, std::false_type)
+{
+   if (parallel) {
+      parallelSort(data, len);
+   }
+   else {
+      std::sort(data, data + len);
+   }
+}
+
+template <typename T>
+inline void hostSort(T* data, const size_t len, const bool parallel)
+{
+   hostSort(data, len, parallel, isRadixSortable<T>{});
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable sort of data by the key returned by keyOf, with the
+///        fastest host algorithm available: radixSort for large arrays
+///        with integer keys, otherwise a stable comparison sort by comp.
+/// @param[in,out] data     - The array to sort
+/// @param[in]     len      - The number of elements to sort
+/// @param[in]     keyOf    - Returns the key of an element
+/// @param[in]     comp     - Strict weak ordering of the elements by key
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename KeyOf, typename Compare>
+inline void hostStableSortByKey(T* data, const size_t len, KeyOf keyOf, Compare comp,
+                                const bool parallel, std::true_type)
+{
+   if (len >= radixSortThreshold) {
+      radixSort(data, len, keyOf, parallel);
+   }
+   else {
+      std::stable_sort(data, data + len, comp);
+   }
+}
+
+template <typename T, typename KeyOf, typename Compare>
+inline void hostStableSortByKey(T* data, const size_t len, KeyOf, Compare comp,
+                                const bool parallel, std::false_type)
+{
+   if (parallel) {
+      parallelSort(data, len, comp, true);
+   }
+   else {
+      std::stable_sort(data, data + len, comp);
+   }
+}
+
+template <typename T, typename KeyOf, typename Compare>
+inline void hostStableSortByKey(T* data, const size_t len, KeyOf keyOf, Compare comp, const bool parallel)
+{
+   typedef typename std::decay<decltype(keyOf(*data))>::type K;
+   hostStableSortByKey(data, len, keyOf, comp, parallel, isRadixSortable<K>{});
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// A key tagged with its position, used to sort separate key and value
+///    arrays through a permutation
+///////////////////////////////////////////////////////////////////////////
+template <typename K>
+struct KeyIndex {
+   K key;
+   size_t index;
+};
+
+template <typename K>
+struct keyIndexKeyOf {
+   K operator()(const KeyIndex<K>& pair) const { return pair.key; }
+};
+
+template <typename K>
+struct keyIndexLess {
+   bool operator()(const KeyIndex<K>& left, const KeyIndex<K>& right) const {
+      return left.key < right.key;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable sort of keys tagged with their original positions (with
+///        hostStableSortByKey, so integer keys get a radix sort)
+/// @param[in]  keys     - The array to sort by
+/// @param[in]  len      - The number of elements to sort
+/// @param[in]  parallel - Whether OpenMP threads may be used
+/// @param[out] sorted   - The sorted keys and the position each came from
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename K>
+inline void sortKeyIndices(const K* keys, const size_t len, const bool parallel,
+                           std::vector<KeyIndex<K>>& sorted)
+{
+   const bool threaded = parallel && hostNumThreads(len) > 1;
+   const long n = (long) len;
+
+   sorted.resize(len);
+
+   CARE_HOST_PARALLEL_FOR_IF(threaded)
+   for (long i = 0; i < n; ++i) {
+      sorted[i].key = keys[i];
+      sorted[i].index = (size_t) i;
+   }
+
+   (void) threaded;
+
+   hostStableSortByKey(sorted.data(), len, keyIndexKeyOf<K>{}, keyIndexLess<K>{}, parallel);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Gathers values through the permutation in sorted
+/// @param[in]     sorted   - Sorted keys and the positions they came from
+/// @param[in,out] values   - The array to permute
+/// @param[in]     len      - The number of elements to permute
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename K, typename V>
+inline void gatherBySortedIndices(const std::vector<KeyIndex<K>>& sorted, V* values,
+                                  const size_t len, const bool parallel)
+{
+   const bool threaded = parallel && hostNumThreads(len) > 1;
+   const long n = (long) len;
+
+   std::vector<V> permuted(len);
+
+   CARE_HOST_PARALLEL_FOR_IF(threaded)
+   for (long i = 0; i < n; ++i) {
+      permuted[i] = values[sorted[i].index];
+   }
+
+   if (threaded) {
+      parallelCopy(permuted.data(), len, values);
+   }
+   else {
+      std::copy(permuted.begin(), permuted.end(), values);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable sort of the separate arrays keys and values by key. The
+///        keys are sorted together with their original positions, then the
+///        values are gathered through that permutation. Neither array is
+///        ever interleaved with the other.
+/// @param[in,out] keys     - The array to sort by
+/// @param[in,out] values   - The array that is permuted along with keys
+/// @param[in]     len      - The number of elements to sort
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename K, typename V>
+inline void stableSortPairs(K* keys, V* values, const size_t len, const bool parallel)
+{
+   if (len < 2) {
+      return;
+   }
+
+   std::vector<KeyIndex<K>> sorted;
+   sortKeyIndices(keys, len, parallel, sorted);
+
+   const bool threaded = parallel && hostNumThreads(len) > 1;
+   const long n = (long) len;
+
+   CARE_HOST_PARALLEL_FOR_IF(threaded)
+   for (long i = 0; i < n; ++i) {
+      keys[i] = sorted[i].key;
+   }
+
+   (void) threaded;
+
+   gatherBySortedIndices(sorted, values, len, parallel);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Same as stableSortPairs, except that the keys are left as they
+///        were. Only values is permuted, so when values starts out as the
+///        identity it ends up as the permutation that sorts keys (argsort).
+/// @param[in]     keys     - The array to sort by
+/// @param[in,out] values   - The array that is permuted
+/// @param[in]     len      - The number of elements to sort
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename K, typename V>
+inline void stableSortValuesByKeys(const K* keys, V* values, const size_t len, const bool parallel)
+{
+   if (len < 2) {
+      return;
+   }
+
+   std::vector<KeyIndex<K>> sorted;
+   sortKeyIndices(keys, len, parallel, sorted);
+   gatherBySortedIndices(sorted, values, len, parallel);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// When one sorted array is at least this many times longer than the other,
+/// intersections gallop through the longer array instead of stepping
+/// through it one element at a time.
+///////////////////////////////////////////////////////////////////////////
+constexpr int gallopRatio = 16;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Finds the first index in [pos, len) at which array[index] is not
+///        less than value by searching exponentially outward from pos and
+///        finishing with a binary search.
+/// @param[in] array - The sorted array to search
+/// @param[in] pos   - The index to start searching from
+/// @param[in] len   - The length of array
+/// @param[in] value - The value to search for
+/// @return The lower bound of value in [pos, len)
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline int gallopLowerBound(const T* array, int pos, const int len, const T& value)
+{
+   int step = 1;
+   int low = pos;
+
+   while (pos < len && array[pos] < value) {
+      low = pos + 1;
+      pos += step;
+      step *= 2;
+   }
+
+   const int high = pos < len ? pos : len;
+   return (int) (std::lower_bound(array + low, array + high, value) - array);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Same as gallopLowerBound, but finds the first index in [pos, len)
+///        at which array[index] is greater than value.
+/// @param[in] array - The sorted array to search
+/// @param[in] pos   - The index to start searching from
+/// @param[in] len   - The length of array
+/// @param[in] value - The value to search for
+/// @return The upper bound of value in [pos, len)
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline int gallopUpperBound(const T* array, int pos, const int len, const T& value)
+{
+   int step = 1;
+   int low = pos;
+
+   while (pos < len && !(value < array[pos])) {
+      low = pos + 1;
+      pos += step;
+      step *= 2;
+   }
+
+   const int high = pos < len ? pos : len;
+   return (int) (std::upper_bound(array + low, array + high, value) - array);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Searches a sorted map for each of a batch of sorted queries.
+///        Consecutive queries gallop forward from the previous result, so
+///        the cost is close to a linear merge when the queries are dense
+///        and close to one binary search per query when they are sparse.
+///        If a query is smaller than the one before it the search restarts
+///        from the beginning of the map, so unsorted input is still correct.
+/// @param[in]  map              - The sorted array to search
+/// @param[in]  start            - The index in map to start searching at
+/// @param[in]  mapSize          - The number of elements to search
+/// @param[in]  queries          - The values to search for
+/// @param[in]  numQueries       - The number of queries
+/// @param[out] results          - The BinarySearch result for each query
+/// @param[in]  returnUpperBound - Same meaning as in BinarySearch
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void sortedBatchSearch(const T* map, const int start, const int mapSize,
+                              const T* queries, const int numQueries,
+                              int* results, const bool returnUpperBound)
+{
+   const T* base = map + start;
+   int pos = 0;
+
+   for (int i = 0; i < numQueries; ++i) {
+      if (i > 0 && queries[i] < queries[i - 1]) {
+         pos = 0;
+      }
+
+      const T& query = queries[i];
+
+      if (returnUpperBound) {
+         pos = gallopUpperBound(base, pos, mapSize, query);
+         results[i] = pos < mapSize ? start + pos : -1;
+      }
+      else {
+         pos = gallopLowerBound(base, pos, mapSize, query);
+         results[i] = (pos < mapSize && base[pos] == query) ? start + pos : -1;
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Splits a batch of sorted queries into one contiguous chunk per
+///        OpenMP thread and runs sortedBatchSearch on each chunk.
+/// @param[in]  map              - The sorted array to search
+/// @param[in]  start            - The index in map to start searching at
+/// @param[in]  mapSize          - The number of elements to search
+/// @param[in]  queries          - The values to search for
+/// @param[in]  numQueries       - The number of queries
+/// @param[out] results          - The BinarySearch result for each query
+/// @param[in]  returnUpperBound - Same meaning as in BinarySearch
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void parallelSortedBatchSearch(const T* map, const int start, const int mapSize,
+                                      const T* queries, const int numQueries,
+                                      int* results, const bool returnUpperBound)
+{
+   const int numThreads = hostNumThreads(numQueries);
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      const int begin = (int) ((size_t) numQueries * t / numThreads);
+      const int end = (int) ((size_t) numQueries * (t + 1) / numThreads);
+
+      sortedBatchSearch(map, start, mapSize, queries + begin, end - begin,
+                        results + begin, returnUpperBound);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sequential intersection of two sorted arrays of unique elements.
+///        Uses a linear merge when the arrays have similar lengths and
+///        gallops through the longer array when they do not.
+/// @param[in]  a1    - The first sorted array
+/// @param[in]  size1 - The length of a1
+/// @param[in]  a2    - The second sorted array
+/// @param[in]  size2 - The length of a2
+/// @param[out] m1    - Indices into a1 of the matches (at least min(size1, size2))
+/// @param[out] m2    - Indices into a2 of the matches (at least min(size1, size2))
+/// @return The number of matches
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline int intersectSorted(const T* a1, const int size1,
+                           const T* a2, const int size2,
+                           int* m1, int* m2)
+{
+   int numMatches = 0;
+
+   if (size1 <= 0 || size2 <= 0) {
+      return numMatches;
+   }
+
+   if (size2 / size1 >= gallopRatio) {
+      int j = 0;
+
+      for (int i = 0; i < size1 && j < size2; ++i) {
+         j = gallopLowerBound(a2, j, size2, a1[i]);
+
+         if (j < size2 && !(a1[i] < a2[j])) {
+            m1[numMatches] = i;
+            m2[numMatches] = j;
+            ++numMatches;
+            ++j;
+         }
+      }
+   }
+   else if (size1 / size2 >= gallopRatio) {
+      int i = 0;
+
+      for (int j = 0; j < size2 && i < size1; ++j) {
+         i = gallopLowerBound(a1, i, size1, a2[j]);
+
+         if (i < size1 && !(a2[j] < a1[i])) {
+            m1[numMatches] = i;
+            m2[numMatches] = j;
+            ++numMatches;
+            ++i;
+         }
+      }
+   }
+   else {
+      int i = 0;
+      int j = 0;
+
+      while (i < size1 && j < size2) {
+         if (a1[i] < a2[j]) {
+            ++i;
+         }
+         else if (a2[j] < a1[i]) {
+            ++j;
+         }
+         else {
+            m1[numMatches] = i;
+            m2[numMatches] = j;
+            ++numMatches;
+            ++i;
+            ++j;
+         }
+      }
+   }
+
+   return numMatches;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Intersection of two sorted arrays of unique elements, split
+///        across OpenMP threads. The work is partitioned with a merge path
+///        search (or evenly over the shorter array when galloping), and the
+///        split points are moved onto equal values so no match straddles
+///        two threads. Falls back to intersectSorted for small inputs.
+/// @param[in]  a1    - The first sorted array
+/// @param[in]  size1 - The length of a1
+/// @param[in]  a2    - The second sorted array
+/// @param[in]  size2 - The length of a2
+/// @param[out] m1    - Indices into a1 of the matches (at least min(size1, size2))
+/// @param[out] m2    - Indices into a2 of the matches (at least min(size1, size2))
+/// @return The number of matches. Matches are in ascending order, the same
+///         as from intersectSorted.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline int parallelIntersectSorted(const T* a1, const int size1,
+                                   const T* a2, const int size2,
+                                   int* m1, int* m2)
+{
+   if (size1 <= 0 || size2 <= 0) {
+      return 0;
+   }
+
+   const int numThreads = hostNumThreads((size_t) size1 + (size_t) size2);
+
+   if (numThreads <= 1) {
+      return intersectSorted(a1, size1, a2, size2, m1, m2);
+   }
+
+   // Partition over the shorter array so that each thread's output fits
+   // in place in m1 and m2, which are only min(size1, size2) long.
+   const bool swapped = size2 < size1;
+   const T* small = swapped ? a2 : a1;
+   const T* large = swapped ? a1 : a2;
+   const int smallSize = swapped ? size2 : size1;
+   const int largeSize = swapped ? size1 : size2;
+   int* smallMatches = swapped ? m2 : m1;
+   int* largeMatches = swapped ? m1 : m2;
+
+   const bool gallop = largeSize / smallSize >= gallopRatio;
+   const size_t total = (size_t) smallSize + (size_t) largeSize;
+
+   std::vector<int> smallBounds(numThreads + 1);
+   std::vector<int> largeBounds(numThreads + 1);
+   std::vector<int> counts(numThreads);
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t <= numThreads; ++t) {
+      int i;
+
+      if (gallop) {
+         i = (int) ((size_t) smallSize * t / numThreads);
+      }
+      else {
+         i = (int) mergePathSearch(small, smallSize, large, largeSize,
+                                   total * t / numThreads, std::less<T>{});
+      }
+
+      smallBounds[t] = i;
+      largeBounds[t] = i < smallSize ?
+                       (int) (std::lower_bound(large, large + largeSize, small[i]) - large) :
+                       largeSize;
+   }
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      const int i0 = smallBounds[t];
+      const int j0 = largeBounds[t];
+
+      int* ms = smallMatches + i0;
+      int* ml = largeMatches + i0;
+
+      const int count = intersectSorted(small + i0, smallBounds[t + 1] - i0,
+                                        large + j0, largeBounds[t + 1] - j0,
+                                        ms, ml);
+
+      for (int k = 0; k < count; ++k) {
+         ms[k] += i0;
+         ml[k] += j0;
+      }
+
+      counts[t] = count;
+   }
+
+   // Each thread wrote its matches at its starting index in the shorter
+   // array, so compacting only ever moves blocks towards the front.
+   int numMatches = 0;
+
+   for (int t = 0; t < numThreads; ++t) {
+      const int i0 = smallBounds[t];
+
+      if (numMatches != i0) {
+         std::copy(smallMatches + i0, smallMatches + i0 + counts[t], smallMatches + numMatches);
+         std::copy(largeMatches + i0, largeMatches + i0 + counts[t], largeMatches + numMatches);
+      }
+
+      numMatches += counts[t];
+   }
+
+   return numMatches;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sorts each segment of data in ascending order, where segment s
+///        is [offsets[s], offsets[s+1]). Tiny segments use a sorting
+///        network and the rest use std::sort, with segments handed out to
+///        threads dynamically since their lengths are often very uneven.
+///        Segments long enough to be worth parallelizing on their own are
+///        instead sorted afterwards, one at a time, with parallelSort.
+/// @param[in,out] data        - The array to sort
+/// @param[in]     offsets     - The numSegments+1 segment boundaries
+/// @param[in]     numSegments - The number of segments
+/// @param[in]     parallel    - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void sortSegments(T* data, const int* offsets, const int numSegments, const bool parallel)
+{
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const size_t total = (size_t) (offsets[numSegments] - offsets[0]);
+   const bool threaded = parallel && hostNumThreads(total) > 1;
+   const int largeSize = threaded ? (int) hostParallelThreshold : offsets[numSegments] - offsets[0] + 1;
+
+   CARE_HOST_PARALLEL_FOR_DYNAMIC_IF(threaded)
+   for (int s = 0; s < numSegments; ++s) {
+      T* segment = data + offsets[s];
+      const int len = offsets[s + 1] - offsets[s];
+
+      if (len <= maxSortingNetworkSize) {
+         sortingNetwork(segment, len);
+      }
+      else if (len < largeSize) {
+         std::sort(segment, segment + len);
+      }
+   }
+
+   if (threaded) {
+      for (int s = 0; s < numSegments; ++s) {
+         const int len = offsets[s + 1] - offsets[s];
+
+         if (len >= largeSize) {
+            parallelSort(data + offsets[s], (size_t) len);
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Removes duplicates from each sorted segment of data in place.
+///        The unique values of segment s are moved to the front of the
+///        segment and the rest of the segment is left unspecified.
+/// @param[in,out] data        - The array with sorted segments
+/// @param[in]     offsets     - The numSegments+1 segment boundaries
+/// @param[in]     numSegments - The number of segments
+/// @param[out]    lengths     - The new length of each segment
+/// @param[in]     parallel    - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void uniqSegments(T* data, const int* offsets, const int numSegments,
+                         int* lengths, const bool parallel)
+{
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const size_t total = (size_t) (offsets[numSegments] - offsets[0]);
+   const bool threaded = parallel && hostNumThreads(total) > 1;
+
+   CARE_HOST_PARALLEL_FOR_DYNAMIC_IF(threaded)
+   for (int s = 0; s < numSegments; ++s) {
+      T* segment = data + offsets[s];
+      const int len = offsets[s + 1] - offsets[s];
+
+      lengths[s] = len > 0 ? (int) (std::unique(segment, segment + len) - segment) : 0;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Keeps the first element of each run of equal elements (for uniq)
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct uniqKeep {
+   const T* data;
+
+   bool operator()(const size_t i) const {
+      return i == 0 || data[i - 1] < data[i] || data[i] < data[i - 1];
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// Keeps the indices that are not in a sorted list of indices to remove
+///////////////////////////////////////////////////////////////////////////
+struct notInSortedList {
+   const int* list;
+   int listLen;
+
+   bool operator()(const size_t i) const {
+      return !std::binary_search(list, list + listLen, (int) i);
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief First pass of an out of place stream compaction. Each thread
+///        counts the indices it keeps in its tile of [0, len), then the
+///        counts are exclusive scanned into the position where each tile
+///        starts writing. Pass the result to compactCopy.
+/// @param[in]  len      - The number of elements to compact
+/// @param[in]  keep     - keep(i) is true if element i is kept
+/// @param[in]  parallel - Whether OpenMP threads may be used
+/// @param[out] offsets  - The start of each tile in the output, followed
+///                        by the total number kept
+/// @return The number of elements kept
+///////////////////////////////////////////////////////////////////////////
+template <typename Keep>
+inline size_t compactOffsets(const size_t len, Keep keep, const bool parallel,
+                             std::vector<size_t>& offsets)
+{
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+
+   offsets.assign(numThreads + 1, 0);
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      size_t count = 0;
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         count += keep(i) ? 1 : 0;
+      }
+
+      offsets[t + 1] = count;
+   }
+
+   for (int t = 0; t < numThreads; ++t) {
+      offsets[t + 1] += offsets[t];
+   }
+
+   return offsets[numThreads];
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Second pass of an out of place stream compaction. Each thread
+///        copies the elements it keeps from its tile of src to dst,
+///        starting at the offset found by compactOffsets.
+/// @param[in]  src     - The array to compact
+/// @param[in]  len     - The number of elements in src
+/// @param[in]  keep    - The same predicate given to compactOffsets
+/// @param[in]  offsets - The result of compactOffsets
+/// @param[out] dst     - Room for offsets.back() elements. Must not alias src.
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Keep>
+inline void compactCopy(const T* src, const size_t len, Keep keep,
+                        const std::vector<size_t>& offsets, T* dst)
+{
+   const int numThreads = (int) offsets.size() - 1;
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      size_t pos = offsets[t];
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         if (keep(i)) {
+            dst[pos++] = src[i];
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stream compaction in place. Each thread compacts its own tile
+///        of data, then the tiles are shifted down to the offsets given by
+///        an exclusive scan of the number kept per tile. Nothing the size
+///        of data is allocated.
+/// @note A tile's destination can overlap the unmoved elements of earlier
+///       tiles, so the shift is done in rounds. Each round moves, in
+///       parallel, every tile whose destination is clear of the elements
+///       of the earlier tiles that have not moved yet. With a similar
+///       fraction kept in every tile, a tile only waits on the tile about
+///       as far into data as its destination, so it takes about log of
+///       the number of threads rounds.
+/// @param[in,out] data     - The array to compact
+/// @param[in]     len      - The number of elements in data
+/// @param[in]     keep     - keep(i) is true if data[i] is kept. It may read
+///                           data[i] and data[i - 1], which still hold their
+///                           original values when keep(i) is called.
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return The number of elements kept, which are at the front of data in
+///         their original order. The rest of data is left unspecified.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename Keep>
+inline size_t compactInPlace(T* data, const size_t len, Keep keep, const bool parallel)
+{
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+
+   std::vector<size_t> counts(numThreads + 1, 0);
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      const size_t begin = len * t / numThreads;
+      size_t pos = begin;
+
+      for (size_t i = begin; i < len * (t + 1) / numThreads; ++i) {
+         if (keep(i)) {
+            // Elements are only written below the one being visited, and
+            // never onto themselves, so neighboring tiles and keep(i + 1)
+            // still see the original data
+            if (pos != i) {
+               data[pos] = data[i];
+            }
+
+            ++pos;
+         }
+      }
+
+      counts[t + 1] = pos - begin;
+   }
+
+   // Turn the counts into the destination of each tile
+   std::vector<size_t> offsets(numThreads + 1, 0);
+
+   for (int t = 0; t < numThreads; ++t) {
+      offsets[t + 1] = offsets[t] + counts[t + 1];
+   }
+
+   // The tiles that still have to move, in order
+   std::vector<int> pending;
+
+   for (int t = 1; t < numThreads; ++t) {
+      if (counts[t + 1] > 0 && offsets[t] != len * t / numThreads) {
+         pending.push_back(t);
+      }
+   }
+
+   std::vector<int> ready;
+   std::vector<int> waiting;
+
+   while (!pending.empty()) {
+      ready.clear();
+      waiting.clear();
+
+      // Tiles only ever move down, so a tile can only land on the elements
+      // of earlier tiles. It is ready once none of those are still pending.
+      for (size_t p = 0; p < pending.size(); ++p) {
+         const int t = pending[p];
+         const size_t dstBegin = offsets[t];
+         const size_t dstEnd = dstBegin + counts[t + 1];
+         bool blocked = false;
+
+         for (size_t q = 0; q < p && !blocked; ++q) {
+            const int s = pending[q];
+            const size_t srcBegin = len * s / numThreads;
+            blocked = srcBegin < dstEnd && dstBegin < srcBegin + counts[s + 1];
+         }
+
+         (blocked ? waiting : ready).push_back(t);
+      }
+
+      const int numReady = (int) ready.size();
+
+      CARE_HOST_PARALLEL_FOR_IF(numReady > 1)
+      for (int r = 0; r < numReady; ++r) {
+         const int t = ready[r];
+         const size_t begin = len * t / numThreads;
+
+         // The destination is below the source, so copying forward is
+         // safe where the two overlap
+         std::copy(data + begin, data + begin + counts[t + 1], data + offsets[t]);
+      }
+
+      pending.swap(waiting);
+   }
+
+   return offsets[numThreads];
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Multiway co-rank search. Finds how many elements of each of k
+///        sorted runs are among the first diag elements of their stable
+///        merge (ties are taken from the lower numbered run first). Each
+///        step pivots on the weighted median of the middles of the
+///        remaining windows, ranks it against every run with one binary
+///        search per run, and so discards at least a quarter of what is
+///        left. That takes O(log n) steps of O(k log n) each.
+/// @param[in]  begins - The start of each run
+/// @param[in]  ends   - The end of each run
+/// @param[in]  k      - The number of runs
+/// @param[in]  diag   - The number of merged elements (at most the total)
+/// @param[out] splits - The number of elements taken from each run
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void multiwaySplit(const T* const* begins, const T* const* ends, const int k,
+                          const size_t diag, size_t* splits)
+{
+   std::vector<size_t> high(k);
+   std::vector<size_t> positions(k);
+   std::vector<int> order;
+
+   order.reserve(k);
+
+   for (int r = 0; r < k; ++r) {
+      splits[r] = 0;
+      high[r] = (size_t) (ends[r] - begins[r]);
+   }
+
+   auto middleOf = [&] (const int r) -> const T& {
+      return begins[r][splits[r] + (high[r] - splits[r]) / 2];
+   };
+
+   // Whether the middle of the window of run a comes before the middle of
+   // the window of run b in the merge
+   auto before = [&] (const int a, const int b) {
+      return middleOf(a) < middleOf(b) || (!(middleOf(b) < middleOf(a)) && a < b);
+   };
+
+   while (true) {
+      order.clear();
+      size_t remaining = 0;
+
+      for (int r = 0; r < k; ++r) {
+         if (splits[r] < high[r]) {
+            order.push_back(r);
+            remaining += high[r] - splits[r];
+         }
+      }
+
+      if (order.empty()) {
+         return;
+      }
+
+      // Pivot on the middle whose window, together with those of the
+      // earlier middles, first holds half of what remains
+      std::sort(order.begin(), order.end(), before);
+
+      int p = order.back();
+      size_t weight = 0;
+
+      for (const int r : order) {
+         weight += high[r] - splits[r];
+
+         if (2 * weight >= remaining) {
+            p = r;
+            break;
+         }
+      }
+
+      const size_t m = splits[p] + (high[p] - splits[p]) / 2;
+      const T& pivot = begins[p][m];
+      size_t rank = 0;
+
+      for (int r = 0; r < k; ++r) {
+         if (r < p) {
+            positions[r] = (size_t) (std::upper_bound(begins[r], ends[r], pivot) - begins[r]);
+         }
+         else if (r > p) {
+            positions[r] = (size_t) (std::lower_bound(begins[r], ends[r], pivot) - begins[r]);
+         }
+         else {
+            positions[r] = m;
+         }
+
+         rank += positions[r];
+      }
+
+      if (rank < diag) {
+         // The pivot and everything before it are in the first diag
+         for (int r = 0; r < k; ++r) {
+            splits[r] = std::max(splits[r], positions[r]);
+         }
+
+         splits[p] = m + 1;
+      }
+      else {
+         for (int r = 0; r < k; ++r) {
+            high[r] = std::min(high[r], positions[r]);
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sequential k-way merge of sorted runs with a loser tree, which
+///        takes log(k) comparisons per element. Ties are taken from the
+///        lower numbered run first.
+/// @param[in]  begins - The start of each run
+/// @param[in]  ends   - The end of each run
+/// @param[in]  k      - The number of runs
+/// @param[out] out    - Storage for the merged elements
+/// @param[in]  uniq   - Whether to drop elements equal to the one before
+/// @param[in]  prev   - If not nullptr, the element before out[0]. Used to
+///                      drop duplicates across calls when uniq is true.
+/// @return The number of elements written to out
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline size_t loserTreeMerge(const T* const* begins, const T* const* ends, const int k,
+                             T* out, const bool uniq, const T* prev)
+{
+   if (k <= 0) {
+      return 0;
+   }
+
+   int numLeaves = 1;
+
+   while (numLeaves < k) {
+      numLeaves *= 2;
+   }
+
+   std::vector<const T*> current(begins, begins + k);
+
+   // Whether run a should be taken before run b. Missing and exhausted
+   // runs lose to everything.
+   auto beats = [&] (const int a, const int b) {
+      const bool aDone = a >= k || current[a] == ends[a];
+      const bool bDone = b >= k || current[b] == ends[b];
+
+      if (aDone || bDone) {
+         return !aDone;
+      }
+
+      return *current[a] < *current[b] || (!(*current[b] < *current[a]) && a < b);
+   };
+
+   // losers[0] is the overall winner, losers[n] the loser at node n
+   std::vector<int> losers(numLeaves);
+   std::vector<int> winners(2 * numLeaves);
+
+   for (int leaf = 0; leaf < numLeaves; ++leaf) {
+      winners[numLeaves + leaf] = leaf;
+   }
+
+   for (int n = numLeaves - 1; n >= 1; --n) {
+      const int left = winners[2 * n];
+      const int right = winners[2 * n + 1];
+
+      if (beats(left, right)) {
+         winners[n] = left;
+         losers[n] = right;
+      }
+      else {
+         winners[n] = right;
+         losers[n] = left;
+      }
+   }
+
+   losers[0] = winners[1];
+
+   size_t numWritten = 0;
+
+   while (true) {
+      int winner = losers[0];
+
+      if (winner >= k || current[winner] == ends[winner]) {
+         break;
+      }
+
+      const T& value = *current[winner];
+      const T* last = numWritten > 0 ? out + numWritten - 1 : prev;
+
+      if (!uniq || last == nullptr || *last < value) {
+         out[numWritten++] = value;
+      }
+
+      ++current[winner];
+
+      // Replay the matches on the path from the winner's leaf to the root
+      for (int n = (numLeaves + winner) / 2; n >= 1; n /= 2) {
+         if (beats(losers[n], winner)) {
+            std::swap(losers[n], winner);
+         }
+      }
+
+      losers[0] = winner;
+   }
+
+   return numWritten;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief k-way merge of sorted runs. With OpenMP the output is split into
+///        equal pieces with multiwaySplit, and each thread merges its piece
+///        with loserTreeMerge.
+/// @param[in]  begins   - The start of each run
+/// @param[in]  ends     - The end of each run
+/// @param[in]  k        - The number of runs
+/// @param[out] out      - Storage for the total length of the runs. Must
+///                        not alias the runs.
+/// @param[in]  uniq     - Whether to drop duplicates from the result
+/// @param[in]  parallel - Whether OpenMP threads may be used
+/// @return The number of elements written to out
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline size_t multiwayMerge(const T* const* begins, const T* const* ends, const int k,
+                            T* out, const bool uniq, const bool parallel)
+{
+   size_t total = 0;
+
+   for (int r = 0; r < k; ++r) {
+      total += (size_t) (ends[r] - begins[r]);
+   }
+
+   const int numThreads = parallel ? hostNumThreads(total) : 1;
+
+   if (numThreads <= 1) {
+      return loserTreeMerge(begins, ends, k, out, uniq, (const T*) nullptr);
+   }
+
+   std::vector<size_t> splits((size_t) (numThreads + 1) * k);
+   std::vector<size_t> counts(numThreads);
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t <= numThreads; ++t) {
+      multiwaySplit(begins, ends, k, total * t / numThreads, &splits[(size_t) t * k]);
+   }
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      const size_t* first = &splits[(size_t) t * k];
+      const size_t* last = &splits[(size_t) (t + 1) * k];
+
+      std::vector<const T*> pieceBegins(k);
+      std::vector<const T*> pieceEnds(k);
+      const T* prev = nullptr;
+
+      for (int r = 0; r < k; ++r) {
+         pieceBegins[r] = begins[r] + first[r];
+         pieceEnds[r] = begins[r] + last[r];
+
+         // The largest element before this piece, for uniq
+         if (first[r] > 0 && (prev == nullptr || *prev < pieceBegins[r][-1])) {
+            prev = pieceBegins[r] - 1;
+         }
+      }
+
+      counts[t] = loserTreeMerge(pieceBegins.data(), pieceEnds.data(), k,
+                                 out + total * t / numThreads, uniq, prev);
+   }
+
+   // Each thread wrote at the start of its piece, so dropping duplicates
+   // only ever moves blocks towards the front.
+   size_t numWritten = 0;
+
+   for (int t = 0; t < numThreads; ++t) {
+      const size_t begin = total * t / numThreads;
+
+      if (numWritten != begin) {
+         std::copy(out + begin, out + begin + counts[t], out + numWritten);
+      }
+
+      numWritten += counts[t];
+   }
+
+   return numWritten;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Orders keys tagged with their positions by key, then by position, so
+///    that a selection of the smallest keys is unique even with ties
+///////////////////////////////////////////////////////////////////////////
+template <typename K>
+struct keyIndexTieLess {
+   bool operator()(const KeyIndex<K>& left, const KeyIndex<K>& right) const {
+      return left.key < right.key ||
+             (!(right.key < left.key) && left.index < right.index);
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// Keeps the indices that are not marked as selected
+///////////////////////////////////////////////////////////////////////////
+struct notSelected {
+   const char* selected;
+
+   bool operator()(const size_t i) const {
+      return selected[i] == 0;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief The number of threads a selection of the k smallest of len
+///        elements should use. Each thread keeps k candidates that are
+///        merged serially, so threads only pay off while the candidates
+///        are fewer than the elements.
+///////////////////////////////////////////////////////////////////////////
+inline int selectNumThreads(const size_t len, const size_t k, const bool parallel)
+{
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+   return k * numThreads < len ? numThreads : 1;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Finds the k smallest elements of data. Each thread scans a tile
+///        of data keeping its k smallest in a max heap, then the
+///        candidates from every thread are merged. The cost is
+///        O(len log k) rather than O(len log len) for a full sort.
+/// @param[in]  data     - The array to select from
+/// @param[in]  len      - The number of elements in data
+/// @param[in]  k        - The number of elements to select
+/// @param[in]  parallel - Whether OpenMP threads may be used
+/// @param[out] smallest - The min(k, len) smallest elements and their
+///                        positions, ordered by value, then by position
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void selectSmallest(const T* data, const size_t len, const size_t k, const bool parallel,
+                           std::vector<KeyIndex<T>>& smallest)
+{
+   const size_t numSelected = std::min(k, len);
+   const keyIndexTieLess<T> less {};
+
+   smallest.clear();
+
+   if (numSelected == 0) {
+      return;
+   }
+
+   const int numThreads = selectNumThreads(len, numSelected, parallel);
+   std::vector<std::vector<KeyIndex<T>>> heaps(numThreads);
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      std::vector<KeyIndex<T>>& heap = heaps[t];
+      heap.reserve(numSelected);
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         const KeyIndex<T> candidate {data[i], i};
+
+         if (heap.size() < numSelected) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), less);
+         }
+         else if (less(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), less);
+         }
+      }
+   }
+
+   for (int t = 0; t < numThreads; ++t) {
+      smallest.insert(smallest.end(), heaps[t].begin(), heaps[t].end());
+   }
+
+   if (smallest.size() > numSelected) {
+      std::nth_element(smallest.begin(), smallest.begin() + numSelected, smallest.end(), less);
+      smallest.resize(numSelected);
+   }
+
+   std::sort(smallest.begin(), smallest.end(), less);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Rearranges data so that its first k elements are its k smallest
+///        in sorted order, like std::partial_sort. With OpenMP, the k
+///        smallest are found by selectSmallest and the rest of data is
+///        stream compacted behind them, so the work is O(len log k) spread
+///        over the threads. Otherwise std::partial_sort is used.
+/// @param[in,out] data     - The array to partially sort
+/// @param[in]     len      - The number of elements in data
+/// @param[in]     k        - The number of elements to sort
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void partialSort(T* data, const size_t len, const size_t k, const bool parallel)
+{
+   const size_t numSorted = std::min(k, len);
+
+   if (selectNumThreads(len, numSorted, parallel) == 1) {
+      std::partial_sort(data, data + numSorted, data + len);
+      return;
+   }
+
+   std::vector<KeyIndex<T>> smallest;
+   selectSmallest(data, len, numSorted, true, smallest);
+
+   // Compact everything that was not selected, then write the selected
+   // elements in front of it
+   std::vector<char> selected(len, 0);
+
+   for (size_t i = 0; i < numSorted; ++i) {
+      selected[smallest[i].index] = 1;
+   }
+
+   const notSelected keep {selected.data()};
+   std::vector<size_t> offsets;
+   std::vector<T> rest(len - numSorted);
+
+   compactOffsets(len, keep, true, offsets);
+   compactCopy(data, len, keep, offsets, rest.data());
+
+   for (size_t i = 0; i < numSorted; ++i) {
+      data[i] = smallest[i].key;
+   }
+
+   parallelCopy(rest.data(), len - numSorted, data + numSorted);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Rearranges data so that data[n] is the element that would be
+///        there if data were sorted, with nothing greater before it and
+///        nothing less after it, like std::nth_element. With OpenMP, a
+///        small n is handled by partialSort, which does the work in
+///        parallel. Otherwise std::nth_element is used.
+/// @param[in,out] data     - The array to rearrange
+/// @param[in]     len      - The number of elements in data
+/// @param[in]     n        - The position to place the element for
+/// @param[in]     parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+inline void nthElement(T* data, const size_t len, const size_t n, const bool parallel)
+{
+   if (n >= len) {
+      return;
+   }
+
+   if (selectNumThreads(len, n + 1, parallel) > 1) {
+      partialSort(data, len, n + 1, true);
+   }
+   else {
+      std::nth_element(data, data + n, data + len);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Counts how many of len elements fall in each of nbins bins.
+///        Each thread counts its tile of [0, len) into private bins, then
+///        the private bins are summed, so no atomics are needed however
+///        few bins there are.
+/// @param[in]  len      - The number of elements to count
+/// @param[in]  nbins    - The number of bins
+/// @param[in]  binOf    - binOf(i) is the bin of element i, or a negative
+///                        number if element i is not counted
+/// @param[out] counts   - The number of elements in each bin
+/// @param[in]  parallel - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename BinOf>
+inline void binCount(const size_t len, const int nbins, BinOf binOf, int* counts,
+                     const bool parallel)
+{
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+
+   std::fill(counts, counts + nbins, 0);
+
+   if (numThreads == 1) {
+      for (size_t i = 0; i < len; ++i) {
+         const int bin = binOf(i);
+
+         if (bin >= 0) {
+            ++counts[bin];
+         }
+      }
+
+      return;
+   }
+
+   std::vector<int> privateCounts((size_t) numThreads * nbins, 0);
+
+   CARE_HOST_PARALLEL_FOR
+   for (int t = 0; t < numThreads; ++t) {
+      int* threadCounts = privateCounts.data() + (size_t) t * nbins;
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         const int bin = binOf(i);
+
+         if (bin >= 0) {
+            ++threadCounts[bin];
+         }
+      }
+   }
+
+   CARE_HOST_PARALLEL_FOR_IF(hostNumThreads(nbins) > 1)
+   for (int b = 0; b < nbins; ++b) {
+      int count = 0;
+
+      for (int t = 0; t < numThreads; ++t) {
+         count += privateCounts[(size_t) t * nbins + b];
+      }
+
+      counts[b] = count;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable partition of src into numBuckets buckets, written to
+///        dst. Each thread counts the elements of its tile that go in
+///        each bucket, the counts are scanned in bucket major order into
+///        the position where each tile starts writing each bucket, and
+///        then each thread scatters its tile.
+/// @param[in]  src        - The array to partition
+/// @param[in]  len        - The number of elements in src
+/// @param[in]  numBuckets - The number of buckets
+/// @param[in]  bucketOf   - bucketOf(i) is the bucket of src[i], in
+///                          [0, numBuckets)
+/// @param[in]  parallel   - Whether OpenMP threads may be used
+/// @param[out] dst        - The elements of src by bucket, in their
+///                          original order within each bucket. Must not
+///                          alias src.
+/// @param[out] offsets    - Room for numBuckets+1 entries. Gets where each
+///                          bucket starts in dst, followed by len.
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BucketOf>
+inline void bucketPartition(const T* src, const size_t len, const int numBuckets,
+                            BucketOf bucketOf, const bool parallel,
+                            T* dst, size_t* offsets)
+{
+   const int numThreads = parallel ? hostNumThreads(len) : 1;
+
+   // The number of elements of each tile in each bucket, and then where
+   // each tile starts writing each bucket
+   std::vector<size_t> starts((size_t) numThreads * numBuckets, 0);
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      size_t* counts = starts.data() + (size_t) t * numBuckets;
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         ++counts[bucketOf(i)];
+      }
+   }
+
+   size_t pos = 0;
+
+   for (int b = 0; b < numBuckets; ++b) {
+      offsets[b] = pos;
+
+      for (int t = 0; t < numThreads; ++t) {
+         const size_t count = starts[(size_t) t * numBuckets + b];
+         starts[(size_t) t * numBuckets + b] = pos;
+         pos += count;
+      }
+   }
+
+   offsets[numBuckets] = pos;
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      size_t* next = starts.data() + (size_t) t * numBuckets;
+
+      for (size_t i = len * t / numThreads; i < len * (t + 1) / numThreads; ++i) {
+         dst[next[bucketOf(i)]++] = src[i];
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Below this many elements host scans stay sequential. A scan does very
+/// little work per element, so it needs more elements than the other host
+/// algorithms before threads pay off.
+///////////////////////////////////////////////////////////////////////////
+constexpr size_t hostScanParallelThreshold = 1 << 17;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Two pass scan. Each thread reduces its tile of in, the tile
+///        sums are scanned sequentially into the carry into each tile,
+///        and then each thread scans its tile starting from its carry.
+///        The result matches a sequential scan exactly for integers. For
+///        floating point types the sums are associated differently, so
+///        they may differ in the last bits.
+/// @param[in]  in        - The array to scan
+/// @param[out] out       - The result. May be the same as in.
+/// @param[in]  len       - The number of elements to scan
+/// @param[in]  op        - The associative operation (such as addition)
+/// @param[in]  init      - The first value of an exclusive scan (unused
+///                         for an inclusive scan)
+/// @param[in]  inclusive - Whether element i of the result includes in[i]
+/// @param[in]  parallel  - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BinaryOp>
+inline void hostScan(const T* in, T* out, const size_t len, BinaryOp op, const T init,
+                     const bool inclusive, const bool parallel)
+{
+   const int numThreads = parallel && len >= hostScanParallelThreshold ? hostNumThreads(len) : 1;
+
+   if (len == 0) {
+      return;
+   }
+
+   // The sum of each tile, then the carry into each tile
+   std::vector<T> carries(numThreads + 1, init);
+
+   if (numThreads > 1) {
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         const size_t begin = len * t / numThreads;
+         const size_t end = len * (t + 1) / numThreads;
+         T sum = in[begin];
+
+         for (size_t i = begin + 1; i < end; ++i) {
+            sum = op(sum, in[i]);
+         }
+
+         carries[t + 1] = sum;
+      }
+
+      // An inclusive scan has no initial value, so the carry into the
+      // second tile is just the sum of the first
+      for (int t = inclusive ? 1 : 0; t < numThreads; ++t) {
+         carries[t + 1] = op(carries[t], carries[t + 1]);
+      }
+   }
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      size_t begin = len * t / numThreads;
+      const size_t end = len * (t + 1) / numThreads;
+      T running = carries[t];
+
+      if (inclusive) {
+         if (t == 0) {
+            running = in[begin];
+            out[begin] = running;
+            ++begin;
+         }
+
+         for (size_t i = begin; i < end; ++i) {
+            running = op(running, in[i]);
+            out[i] = running;
+         }
+      }
+      else {
+         for (size_t i = begin; i < end; ++i) {
+            const T value = in[i];
+            out[i] = running;
+            running = op(running, value);
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Two pass segmented scan, which restarts at the head of each
+///        segment. Each thread reduces the part of its tile after the last
+///        head in the tile, those are scanned sequentially into the carry
+///        into each tile, and then each thread scans its tile starting
+///        from its carry.
+/// @param[in]  in        - The array to scan
+/// @param[out] out       - The result. May be the same as in.
+/// @param[in]  len       - The number of elements to scan
+/// @param[in]  isHead    - isHead(i) is true if element i starts a segment.
+///                         Element 0 always starts a segment.
+/// @param[in]  op        - The associative operation (such as addition)
+/// @param[in]  init      - The first value of each segment of an exclusive
+///                         scan (unused for an inclusive scan)
+/// @param[in]  inclusive - Whether element i of the result includes in[i]
+/// @param[in]  parallel  - Whether OpenMP threads may be used
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename IsHead, typename BinaryOp>
+inline void hostSegmentedScan(const T* in, T* out, const size_t len, IsHead isHead,
+                              BinaryOp op, const T init, const bool inclusive,
+                              const bool parallel)
+{
+   const int numThreads = parallel && len >= hostScanParallelThreshold ? hostNumThreads(len) : 1;
+
+   if (len == 0) {
+      return;
+   }
+
+   // The sum of each tile after its last head, then the sum of the
+   // segment that is open at the start of each tile
+   std::vector<T> carries(numThreads, init);
+   std::vector<char> hasHead(numThreads, 0);
+
+   if (numThreads > 1) {
+      CARE_HOST_PARALLEL_FOR
+      for (int t = 0; t < numThreads; ++t) {
+         const size_t begin = len * t / numThreads;
+         const size_t end = len * (t + 1) / numThreads;
+         T sum = in[begin];
+
+         hasHead[t] = begin == 0 || isHead(begin);
+
+         for (size_t i = begin + 1; i < end; ++i) {
+            if (isHead(i)) {
+               sum = in[i];
+               hasHead[t] = 1;
+            }
+            else {
+               sum = op(sum, in[i]);
+            }
+         }
+
+         carries[t] = sum;
+      }
+
+      // Tile 0 always starts with a head, so nothing carries into it
+      T carry = carries[0];
+
+      for (int t = 1; t < numThreads; ++t) {
+         const T tail = carries[t];
+         carries[t] = carry;
+         carry = hasHead[t] ? tail : op(carry, tail);
+      }
+   }
+
+   CARE_HOST_PARALLEL_FOR_IF(numThreads > 1)
+   for (int t = 0; t < numThreads; ++t) {
+      const size_t begin = len * t / numThreads;
+      const size_t end = len * (t + 1) / numThreads;
+
+      if (inclusive) {
+         T running = carries[t];
+
+         for (size_t i = begin; i < end; ++i) {
+            running = i == 0 || isHead(i) ? in[i] : op(running, in[i]);
+            out[i] = running;
+         }
+      }
+      else {
+         T running = t == 0 ? init : op(init, carries[t]);
+
+         for (size_t i = begin; i < end; ++i) {
+            const T value = in[i];
+
+            if (i == 0 || isHead(i)) {
+               running = init;
+            }
+
+            out[i] = running;
+            running = op(running, value);
+         }
+      }
+   }
+}
+
+} // namespace detail
+} // namespace care
+
+#endif // !defined(_CARE_HOST_ALGORITHM_H_)
@@ -0,0 +1,481 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_PARTITION_H_
+#define _CARE_PARTITION_H_
+
+// This header splits an array by a predicate (or by flags), or into any
+// number of buckets, keeping the original order within each part. Each
+// backend counts and scatters the elements in one fused pass over tiles of
+// the array instead of one compaction per part. CopyIf and TransformCopyIf
+// keep just the first part, out of place, without any flag or scan arrays
+// the size of the input. The functions take arbitrary predicates, so they
+// are defined here rather than being instantiated in care_inst.h.
+
+// CARE config header
+#include "care/config.h"
+
+// CARE headers
+#include "care/algorithm_decl.h"
+#include "care/DefaultMacros.h"
+#include "care/host_algorithm.h"
+#include "care/host_device_ptr.h"
+#include "care/host_ptr.h"
+#include "care/policies.h"
+#include "care/scan.h"
+
+// Std library headers
+#include <algorithm>
+#include <vector>
+
+namespace care {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////
+/// Puts the elements that satisfy a predicate in bucket 0 and the rest in
+/// bucket 1
+///////////////////////////////////////////////////////////////////////////
+template <typename Predicate>
+struct PredicateBucket {
+   Predicate predicate;
+
+   template <typename T>
+   CARE_HOST_DEVICE int operator()(const T& value) const {
+      return predicate(value) ? 0 : 1;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// Stands in for the bucket function when the buckets come from flags
+///////////////////////////////////////////////////////////////////////////
+struct NoBucket {
+   template <typename T>
+   CARE_HOST_DEVICE int operator()(const T&) const {
+      return 0;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Host version of PartitionBuckets (see care::detail::bucketPartition)
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BucketOf>
+inline void HostPartitionBuckets(host_device_ptr<T> array, host_device_ptr<const int> flags,
+                                 const int n, const int numBuckets, BucketOf bucketOf,
+                                 host_device_ptr<int> offsets, const bool parallel)
+{
+   T * data = host_ptr<T>(array).data();
+   const int * hostFlags = flags ? host_ptr<const int>(flags).cdata() : nullptr;
+
+   auto hostBucketOf = [=] (const size_t i) {
+      return hostFlags ? (hostFlags[i] != 0 ? 0 : 1) : bucketOf(data[i]);
+   };
+
+   std::vector<T> partitioned(n);
+   std::vector<size_t> hostOffsets(numBuckets + 1);
+
+   bucketPartition(data, (size_t) n, numBuckets, hostBucketOf, parallel,
+                   partitioned.data(), hostOffsets.data());
+
+   parallelCopy(partitioned.data(), (size_t) n, data);
+
+   int * result = host_ptr<int>(offsets).data();
+
+   for (int b = 0; b <= numBuckets; ++b) {
+      result[b] = (int) hostOffsets[b];
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable partition of the n > 0 elements of array into numBuckets
+///        buckets, in place. The bucket of element i is 0 if flags[i] is
+///        nonzero and 1 otherwise when flags is given, and
+///        bucketOf(array[i]) when it is not. offsets gets where each
+///        bucket starts, followed by n.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BucketOf>
+inline void PartitionBuckets(RAJA::seq_exec, host_device_ptr<T> array, host_device_ptr<const int> flags,
+                             const int n, const int numBuckets, BucketOf bucketOf,
+                             host_device_ptr<int> offsets)
+{
+   HostPartitionBuckets(array, flags, n, numBuckets, bucketOf, offsets, false);
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+///
+/// The fewest elements each loop iteration counts and scatters. Tiles are
+/// kept small so that neighboring threads read nearby elements.
+///
+constexpr int partitionTileSize = 16;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief GPU version of PartitionBuckets. The array is copied aside,
+///        each loop iteration counts the elements of one tile that go in
+///        each bucket, the counts are scanned in bucket major order into
+///        the position where each tile starts writing each bucket, and
+///        then each tile is scattered straight back into array. Tiles
+///        have at least as many elements as there are buckets, which keeps
+///        the counts no longer than the array.
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BucketOf>
+inline void PartitionBuckets(RAJADeviceExec, host_device_ptr<T> array, host_device_ptr<const int> flags,
+                             const int n, const int numBuckets, BucketOf bucketOf,
+                             host_device_ptr<int> offsets)
+{
+   const bool useFlags = (bool) flags;
+   const int tileSize = care::max(partitionTileSize, numBuckets);
+   const int numTiles = (n + tileSize - 1) / tileSize;
+   const int numStarts = numBuckets * numTiles;
+
+   host_device_ptr<T> original(n, "PartitionBuckets original");
+
+   CARE_STREAM_LOOP(i, 0, n) {
+      original[i] = array[i];
+   } CARE_STREAM_LOOP_END
+
+   // Entry b * numTiles + t is the number of elements of tile t in
+   // bucket b, and then where tile t starts writing bucket b. The last
+   // entry is a 0, so the scan leaves n there.
+   host_device_ptr<int> starts(numStarts + 1, "PartitionBuckets starts");
+
+   CARE_STREAM_LOOP(t, 0, numTiles + 1) {
+      if (t == numTiles) {
+         starts[numStarts] = 0;
+      }
+      else {
+         for (int b = 0; b < numBuckets; ++b) {
+            starts[b * numTiles + t] = 0;
+         }
+
+         const int end = care::min((t + 1) * tileSize, n);
+
+         for (int i = t * tileSize; i < end; ++i) {
+            const int b = useFlags ? (flags[i] != 0 ? 0 : 1) : bucketOf(original[i]);
+            ++starts[b * numTiles + t];
+         }
+      }
+   } CARE_STREAM_LOOP_END
+
+   care::exclusive_scan(RAJADeviceExec{}, starts, nullptr, numStarts + 1, 0, true);
+
+   CARE_STREAM_LOOP(b, 0, numBuckets + 1) {
+      offsets[b] = starts[b * numTiles];
+   } CARE_STREAM_LOOP_END
+
+   CARE_STREAM_LOOP(t, 0, numTiles) {
+      const int end = care::min((t + 1) * tileSize, n);
+
+      for (int i = t * tileSize; i < end; ++i) {
+         const int b = useFlags ? (flags[i] != 0 ? 0 : 1) : bucketOf(original[i]);
+         array[starts[b * numTiles + t]++] = original[i];
+      }
+   } CARE_STREAM_LOOP_END
+
+   starts.free();
+   original.free();
+}
+
+#else // defined(CARE_GPUCC)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief OpenMP version of PartitionBuckets (see care::detail::bucketPartition)
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BucketOf>
+inline void PartitionBuckets(RAJADeviceExec, host_device_ptr<T> array, host_device_ptr<const int> flags,
+                             const int n, const int numBuckets, BucketOf bucketOf,
+                             host_device_ptr<int> offsets)
+{
+   HostPartitionBuckets(array, flags, n, numBuckets, bucketOf, offsets, true);
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Two way partition shared by StablePartition and
+///        StablePartitionByFlags
+/// @return The number of elements in the first part
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename BucketOf>
+inline int TwoWayPartition(Exec, host_device_ptr<T> array, host_device_ptr<const int> flags,
+                           const int n, BucketOf bucketOf)
+{
+   if (n <= 0) {
+      return 0;
+   }
+
+   host_device_ptr<int> offsets(3, "StablePartition offsets");
+   PartitionBuckets(Exec{}, array, flags, n, 2, bucketOf, offsets);
+
+   const int split = offsets.pick(1);
+   offsets.free();
+
+   return split;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief The number of tiles TransformCopyIf splits [0, n) into. Each
+///        loop iteration counts and then scatters one tile.
+///////////////////////////////////////////////////////////////////////////
+inline int CopyIfTiles(RAJA::seq_exec, const int)
+{
+   return 1;
+}
+
+#ifdef CARE_PARALLEL_DEVICE
+
+#ifdef CARE_GPUCC
+
+///
+/// The most indices in a tile of TransformCopyIf on the device. Tiles are
+/// kept small so that neighboring threads read nearby indices.
+///
+constexpr int copyIfTileSize = 16;
+
+inline int CopyIfTiles(RAJADeviceExec, const int n)
+{
+   return (n + copyIfTileSize - 1) / copyIfTileSize;
+}
+
+#else // defined(CARE_GPUCC)
+
+inline int CopyIfTiles(RAJADeviceExec, const int n)
+{
+   return hostNumThreads((size_t) n);
+}
+
+#endif // defined(CARE_GPUCC)
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief TransformCopyIf that writes at most the first maxKept elements
+///        it keeps, and returns how many it wrote
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename Transform, typename Predicate>
+inline int TransformCopyFirstIf(Exec, const int n, const int maxKept, host_device_ptr<T> out,
+                                Transform transform, Predicate predicate)
+{
+   if (n <= 0 || maxKept <= 0) {
+      return 0;
+   }
+
+   const int numTiles = CopyIfTiles(Exec{}, n);
+
+   // The number kept by each tile, and where each tile starts writing
+   host_device_ptr<int> counts(numTiles, "TransformCopyIf counts");
+   host_device_ptr<int> offsets(numTiles, "TransformCopyIf offsets");
+
+   CARE_LOOP(Exec{}, t, 0, numTiles) {
+      const int begin = (int) ((long long) n * t / numTiles);
+      const int end = (int) ((long long) n * (t + 1) / numTiles);
+      int count = 0;
+
+      for (int i = begin; i < end; ++i) {
+         count += predicate(i) ? 1 : 0;
+      }
+
+      counts[t] = count;
+   } CARE_LOOP_END
+
+   chai::ManagedArray<int> keptCount(1, CARE_SCANVARLENGTHNAME_SPACE);
+   care::exclusive_scan(Exec{}, counts, offsets, numTiles, 0, false, keptCount);
+
+   int numKept = 0;
+   care::getFinalScanCountFromPinned(keptCount, numKept);
+   keptCount.free();
+
+   if (numKept > 0) {
+      CARE_LOOP(Exec{}, t, 0, numTiles) {
+         const int begin = (int) ((long long) n * t / numTiles);
+         const int end = (int) ((long long) n * (t + 1) / numTiles);
+         int position = offsets[t];
+
+         for (int i = begin; i < end && position < maxKept; ++i) {
+            if (predicate(i)) {
+               out[position++] = transform(i);
+            }
+         }
+      } CARE_LOOP_END
+   }
+
+   offsets.free();
+   counts.free();
+
+   return numKept < maxKept ? numKept : maxKept;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// The transform and predicate CopyIf hands to TransformCopyIf
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct ElementAt {
+   host_device_ptr<const T> array;
+
+   CARE_HOST_DEVICE T operator()(const int i) const {
+      return array[i];
+   }
+};
+
+template <typename T, typename Predicate>
+struct ElementSatisfies {
+   host_device_ptr<const T> array;
+   Predicate predicate;
+
+   CARE_HOST_DEVICE bool operator()(const int i) const {
+      return predicate(array[i]);
+   }
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Moves the elements of array that satisfy predicate in front of
+///    the ones that do not, keeping the original order within each part
+///    (like std::stable_partition).
+/// @param[in,out] array   - The array to partition
+/// @param[in] n           - The number of elements in array
+/// @param[in] predicate   - A CARE_HOST_DEVICE function object taking an
+///                          element of array and returning a bool
+/// @return The number of elements that satisfy predicate
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename Predicate>
+inline int StablePartition(Exec, host_device_ptr<T> array, const int n, Predicate predicate)
+{
+   return detail::TwoWayPartition(Exec{}, array, nullptr, n,
+                                  detail::PredicateBucket<Predicate>{predicate});
+}
+
+template <typename T, typename Predicate>
+inline int StablePartition(host_device_ptr<T> array, const int n, Predicate predicate)
+{
+   return StablePartition(RAJAExec{}, array, n, predicate);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Same as StablePartition, but the elements in front are the ones
+///    whose flag is nonzero.
+/// @param[in,out] array - The array to partition
+/// @param[in] n         - The number of elements in array
+/// @param[in] flags     - A flag for each element of array
+/// @return The number of nonzero flags
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T>
+inline int StablePartitionByFlags(Exec, host_device_ptr<T> array, const int n,
+                                  host_device_ptr<const int> flags)
+{
+   return detail::TwoWayPartition(Exec{}, array, flags, n, detail::NoBucket{});
+}
+
+template <typename T>
+inline int StablePartitionByFlags(host_device_ptr<T> array, const int n,
+                                  host_device_ptr<const int> flags)
+{
+   return StablePartitionByFlags(RAJAExec{}, array, n, flags);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Stable partition of array into numBuckets buckets, which is
+///    also a counting sort by bucket. Elements of bucket 0 come first,
+///    then bucket 1, and so on, in their original order within each
+///    bucket.
+/// @param[in,out] array  - The array to partition
+/// @param[in] n          - The number of elements in array
+/// @param[in] numBuckets - The number of buckets
+/// @param[in] bucketOf   - A CARE_HOST_DEVICE function object taking an
+///                         element of array and returning its bucket in
+///                         [0, numBuckets)
+/// @param[out] offsets   - Room for numBuckets+1 entries. Gets where each
+///                         bucket starts in array, followed by n.
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename BucketOf>
+inline void MultiwayPartition(Exec, host_device_ptr<T> array, const int n, const int numBuckets,
+                              BucketOf bucketOf, host_device_ptr<int> offsets)
+{
+   if (numBuckets <= 0) {
+      return;
+   }
+
+   if (n <= 0) {
+      int * result = host_ptr<int>(offsets).data();
+      std::fill(result, result + numBuckets + 1, 0);
+      return;
+   }
+
+   detail::PartitionBuckets(Exec{}, array, nullptr, n, numBuckets, bucketOf, offsets);
+}
+
+template <typename T, typename BucketOf>
+inline void MultiwayPartition(host_device_ptr<T> array, const int n, const int numBuckets,
+                              BucketOf bucketOf, host_device_ptr<int> offsets)
+{
+   MultiwayPartition(RAJAExec{}, array, n, numBuckets, bucketOf, offsets);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Writes transform(i) to out, in order, for each i in [0, n) for
+///    which predicate(i) is true. The indices are split into tiles, each
+///    loop iteration counts the indices its tile keeps, the counts are
+///    scanned with care::exclusive_scan into where each tile starts
+///    writing, and then each iteration scatters its tile. There are no
+///    flag or scan arrays the size of the input, and the scan writes the
+///    count to pinned memory instead of needing a pick. predicate is
+///    called twice per index.
+/// @param[in] n          - The number of indices
+/// @param[out] out       - Room for as many elements as are kept (at most n)
+/// @param[in] transform  - A CARE_HOST_DEVICE function object taking an
+///                         index and returning the element to write
+/// @param[in] predicate  - A CARE_HOST_DEVICE function object taking an
+///                         index and returning whether to keep it
+/// @return The number of elements written to out
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename Transform, typename Predicate>
+inline int TransformCopyIf(Exec, const int n, host_device_ptr<T> out,
+                           Transform transform, Predicate predicate)
+{
+   return detail::TransformCopyFirstIf(Exec{}, n, n, out, transform, predicate);
+}
+
+template <typename T, typename Transform, typename Predicate>
+inline int TransformCopyIf(const int n, host_device_ptr<T> out,
+                           Transform transform, Predicate predicate)
+{
+   return TransformCopyIf(RAJAExec{}, n, out, transform, predicate);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Copies the elements of in that satisfy predicate to out, in
+///    order (like std::copy_if). See TransformCopyIf.
+/// @param[in] in         - The array to copy from
+/// @param[in] n          - The number of elements in in
+/// @param[out] out       - Room for as many elements as are kept (at most n)
+/// @param[in] predicate  - A CARE_HOST_DEVICE function object taking an
+///                         element of in and returning a bool
+/// @return The number of elements copied
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename T, typename Predicate>
+inline int CopyIf(Exec, host_device_ptr<const T> in, const int n, host_device_ptr<T> out,
+                  Predicate predicate)
+{
+   return TransformCopyIf(Exec{}, n, out, detail::ElementAt<T>{in},
+                          detail::ElementSatisfies<T, Predicate>{in, predicate});
+}
+
+template <typename T, typename Predicate>
+inline int CopyIf(host_device_ptr<const T> in, const int n, host_device_ptr<T> out,
+                  Predicate predicate)
+{
+   return CopyIf(RAJAExec{}, in, n, out, predicate);
+}
+
+} // namespace care
+
+#endif // !defined(_CARE_PARTITION_H_)
@@ -0,0 +1,263 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_PERMUTATION_H_
+#define _CARE_PERMUTATION_H_
+
+// This header applies one permutation (such as the keys of a KeyValueSorter
+// after a sort) to any number of arrays of any types at once. Every array is
+// handled in the same pass over the permutation, so the permutation is read
+// once and there is one loop (and one set of loop hooks) instead of one per
+// array. The functions are variadic templates, so they are defined here
+// rather than being instantiated in care_inst.h.
+
+// CARE config header
+#include "care/config.h"
+
+// CARE headers
+#include "care/algorithm_decl.h"
+#include "care/DefaultMacros.h"
+#include "care/host_device_ptr.h"
+#include "care/host_ptr.h"
+#include "care/policies.h"
+
+// Std library headers
+#include <vector>
+
+namespace care {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Holds a source array and a newly allocated destination array
+///        for each of the arrays being permuted, and copies one element of
+///        every array per call to gather. Captured by value in CARE loops.
+///////////////////////////////////////////////////////////////////////////
+template <typename... Ts>
+struct PermutationGather;
+
+template <>
+struct PermutationGather<> {
+   explicit PermutationGather(const int) {}
+
+   CARE_HOST_DEVICE void gather(const int, const int) const {}
+
+   CARE_HOST_DEVICE void gather(const host_device_ptr<const int>&, const int, const int) const {}
+
+   void replace() {}
+};
+
+template <typename T, typename... Ts>
+struct PermutationGather<T, Ts...> {
+   PermutationGather(const int n, const host_device_ptr<T>& array, const host_device_ptr<Ts>&... arrays)
+   : m_source(array)
+   , m_destination(n, "ApplyPermutation")
+   , m_rest(n, arrays...)
+   {
+   }
+
+   ///
+   /// Sets element i of every destination array to element j of its source
+   ///
+   CARE_HOST_DEVICE void gather(const int i, const int j) const {
+      m_destination[i] = m_source[j];
+      m_rest.gather(i, j);
+   }
+
+   ///
+   /// Gathers elements [begin, end) of one destination array after
+   /// another, so the permutation tile stays in cache for every array
+   ///
+   CARE_HOST_DEVICE void gather(const host_device_ptr<const int>& permutation,
+                                const int begin, const int end) const {
+      for (int i = begin; i < end; ++i) {
+         m_destination[i] = m_source[permutation[i]];
+      }
+
+      m_rest.gather(permutation, begin, end);
+   }
+
+   ///
+   /// Frees the source arrays and replaces them with the destination arrays
+   ///
+   void replace(host_device_ptr<T>& array, host_device_ptr<Ts>&... arrays) {
+      array.free();
+      array = m_destination;
+      m_rest.replace(arrays...);
+   }
+
+   host_device_ptr<const T> m_source;
+   host_device_ptr<T> m_destination;
+   PermutationGather<Ts...> m_rest;
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// The number of elements each iteration of ApplyPermutation gathers. Host
+/// threads gather a tile of every array at a time. On the device one
+/// element per thread already makes each warp a tile whose reads of the
+/// permutation and writes to every array are coalesced.
+///////////////////////////////////////////////////////////////////////////
+inline int permutationTileSize(RAJA::seq_exec)
+{
+   return 1024;
+}
+
+template <typename Exec>
+inline int permutationTileSize(Exec)
+{
+#if defined(CARE_GPUCC)
+   return 1;
+#else
+   return 1024;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Holds a host pointer to each of the arrays being permuted in
+///        place, along with room to save one element of each while a
+///        cycle of the permutation is followed.
+///////////////////////////////////////////////////////////////////////////
+template <typename... Ts>
+struct PermutationCycle;
+
+template <>
+struct PermutationCycle<> {
+   void save(const int) {}
+   void move(const int, const int) {}
+   void restore(const int) {}
+};
+
+template <typename T, typename... Ts>
+struct PermutationCycle<T, Ts...> {
+   explicit PermutationCycle(host_device_ptr<T>& array, host_device_ptr<Ts>&... arrays)
+   : m_data(host_ptr<T>(array).data())
+   , m_saved()
+   , m_rest(arrays...)
+   {
+   }
+
+   void save(const int i) {
+      m_saved = m_data[i];
+      m_rest.save(i);
+   }
+
+   void move(const int dst, const int src) {
+      m_data[dst] = m_data[src];
+      m_rest.move(dst, src);
+   }
+
+   void restore(const int dst) {
+      m_data[dst] = m_saved;
+      m_rest.restore(dst);
+   }
+
+   T * m_data;
+   T m_saved;
+   PermutationCycle<Ts...> m_rest;
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Permutes any number of arrays by the same permutation, so that
+///    element i of each array becomes its old element permutation[i]
+///    (a gather, as with the keys of a KeyValueSorter after a sort).
+///    All the arrays are gathered in a single loop over tiles of the
+///    permutation into newly allocated arrays, which then replace the
+///    originals (the originals are freed).
+/// @param[in] permutation - The index of the old element for each new element
+/// @param[in] n           - The number of elements in the permutation
+/// @param[in,out] arrays  - The arrays to permute, each with at least n elements
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename Exec, typename... Ts>
+inline void ApplyPermutation(Exec, host_device_ptr<const int> permutation, const int n,
+                             host_device_ptr<Ts>&... arrays)
+{
+   if (n <= 0 || sizeof...(Ts) == 0) {
+      return;
+   }
+
+   detail::PermutationGather<Ts...> gather(n, arrays...);
+   const int tileSize = detail::permutationTileSize(Exec{});
+
+   if (tileSize == 1) {
+      CARE_LOOP(Exec{}, i, 0, n) {
+         gather.gather(i, permutation[i]);
+      } CARE_LOOP_END
+   }
+   else {
+      const int numTiles = (n + tileSize - 1) / tileSize;
+
+      CARE_LOOP(Exec{}, t, 0, numTiles) {
+         const int begin = t * tileSize;
+         gather.gather(permutation, begin, care::min(begin + tileSize, n));
+      } CARE_LOOP_END
+   }
+
+   gather.replace(arrays...);
+}
+
+template <typename... Ts>
+inline void ApplyPermutation(host_device_ptr<const int> permutation, const int n,
+                             host_device_ptr<Ts>&... arrays)
+{
+   ApplyPermutation(RAJAExec{}, permutation, n, arrays...);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Same as ApplyPermutation, but done in place on the host by
+///    following the cycles of the permutation, so no copies of the arrays
+///    are allocated. Each cycle is followed once for all the arrays.
+/// @param[in] permutation - The index of the old element for each new element
+/// @param[in] n           - The number of elements in the permutation
+/// @param[in,out] arrays  - The arrays to permute, each with at least n elements
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename... Ts>
+inline void ApplyPermutationInPlace(host_device_ptr<const int> permutation, const int n,
+                                    host_device_ptr<Ts>&... arrays)
+{
+   if (n <= 0 || sizeof...(Ts) == 0) {
+      return;
+   }
+
+   const int * perm = host_ptr<const int>(permutation).cdata();
+   detail::PermutationCycle<Ts...> cycle(arrays...);
+   std::vector<bool> done(n, false);
+
+   for (int start = 0; start < n; ++start) {
+      if (done[start]) {
+         continue;
+      }
+
+      done[start] = true;
+
+      if (perm[start] == start) {
+         continue;
+      }
+
+      // Save the start of the cycle, shift every element along it, then
+      // put the saved element where the cycle closes
+      cycle.save(start);
+
+      int dst = start;
+      int src = perm[start];
+
+      while (src != start) {
+         cycle.move(dst, src);
+         done[src] = true;
+         dst = src;
+         src = perm[src];
+      }
+
+      cycle.restore(dst);
+   }
+}
+
+} // namespace care
+
+#endif // !defined(_CARE_PERMUTATION_H_)
@@ -28,6 +28,19 @@
 
 namespace care {
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// generic scan functionality
+
+// Scans of any trivially copyable type with any associative binop (a CARE_HOST_DEVICE function object). These are
+// defined in scan_impl.h; the overloads below are the instantiations for addition that are built into the library.
+template <typename T, typename Exec, typename Fn, typename ValueType=T>
+void exclusive_scan(chai::ManagedArray<T> data, chai::ManagedArray<T> outData,
+                    int size, Fn binop, ValueType val, bool inPlace);
+
+template <typename T, typename Exec, typename Fn, typename ValueType=T>
+void inclusive_scan(chai::ManagedArray<T> data, chai::ManagedArray<T> outData,
+                    int size, Fn binop, bool inPlace);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // exclusive scan functionality
 
@@ -38,6 +51,10 @@ void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedA
 CARE_DLL_API
 void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
                     int size, int val);
+// scan that also writes the total (the value after the last element) to scanTotal[0], which may be pinned
+CARE_DLL_API
+void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                    int size, int val, bool inPlace, chai::ManagedArray<int> scanTotal);
 
 #ifdef CARE_PARALLEL_DEVICE
 
@@ -48,6 +65,10 @@ void exclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedA
 CARE_DLL_API
 void exclusive_scan(RAJADeviceExec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
                     int size, int val);
+// scan that also writes the total (the value after the last element) to scanTotal[0], which may be pinned
+CARE_DLL_API
+void exclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                    int size, int val, bool inPlace, chai::ManagedArray<int> scanTotal);
 
 #endif // defined(CARE_PARALLEL_DEVICE)
 
@@ -100,6 +121,10 @@ void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::Mana
 CARE_DLL_API
 void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
                     int size, GIDTYPE val);
+// scan that also writes the total (the value after the last element) to scanTotal[0], which may be pinned
+CARE_DLL_API
+void exclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                    int size, GIDTYPE val, bool inPlace, chai::ManagedArray<GIDTYPE> scanTotal);
 
 #ifdef CARE_PARALLEL_DEVICE
 
@@ -110,6 +135,10 @@ void exclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::Mana
 CARE_DLL_API
 void exclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
                     int size, GIDTYPE val);
+// scan that also writes the total (the value after the last element) to scanTotal[0], which may be pinned
+CARE_DLL_API
+void exclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                    int size, GIDTYPE val, bool inPlace, chai::ManagedArray<GIDTYPE> scanTotal);
 
 #endif // defined(CARE_PARALLEL_DEVICE)
 
@@ -202,6 +231,265 @@ void inclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, ch
 
 #endif // CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// segmented scan functionality
+//
+// Same as exclusive_scan and inclusive_scan, but the scan restarts at the first element of each segment. Segments
+// are given either as a flag for each element that is true for the first element of a segment, or as the offsets
+// of the first element of each segment. The first element is always the start of a segment.
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+#if CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJA::seq_exec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJA::seq_exec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#ifdef CARE_PARALLEL_DEVICE
+
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags);
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_exclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val);
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace);
+// typesafe wrapper for out of place scan
+CARE_DLL_API
+void segmented_inclusive_scan(RAJADeviceExec, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments);
+
+#endif // defined(CARE_PARALLEL_DEVICE)
+
+#endif // CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // scan count accessors
 
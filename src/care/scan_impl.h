@@ -5,21 +5,27 @@
 // SPDX-License-Identifier: BSD-3-Clause
 //////////////////////////////////////////////////////////////////////////////////////
 
-// This header should be included once for each execution policy, defined by
-// CARE_SCAN_EXEC.  This header should only be needed within CARE proper and
-// should not be included by the host code.
-
-#ifndef CARE_SCAN_EXEC
-#error "CARE_SCAN_EXEC must be defined"
-#endif
-
+// This header defines the scan templates declared in scan.h. scan.cpp
+// includes it once for each execution policy, defined by CARE_SCAN_EXEC, to
+// build the overloads declared in scan.h for that policy. algorithm_impl.h
+// includes it without CARE_SCAN_EXEC, which defines only the templates, so
+// ExclusiveScan and InclusiveScan can instantiate them for any type and
+// operation. Host code gets it that way through algorithm.h, and should not
+// include it directly.
+
+#include "care/algorithm_decl.h"
 #include "care/CHAICallback.h"
 #include "care/CHAIDataGetter.h"
 #include "care/DefaultMacros.h"
+#include "care/host_algorithm.h"
+#include "care/host_device_ptr.h"
+#include "care/host_ptr.h"
 #include "care/scan.h"
 
 #include "umpire/util/backtrace.hpp"
 
+#include <type_traits>
+
 #if CARE_HAVE_LLNL_GLOBALID
 #include "LLNL_GlobalID.h"
 #endif // CARE_HAVE_LLNL_GLOBALID
@@ -33,16 +39,39 @@ namespace care {
 // Template helper functions for implementations
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+// Whether scans with the given policy run on the host. Those use the two pass scan in care::detail::hostScan, which
+// is threaded once the array is long enough if isParallelHostScanExec is also true.
+template <typename Exec>
+struct isHostScanExec : std::integral_constant<bool,
+#if defined(CARE_GPUCC)
+                                               std::is_same<Exec, RAJA::seq_exec>::value
+#else
+                                               true
+#endif
+                                               > {};
+
+// Whether host scans with the given policy may use OpenMP threads. That is only the OpenMP RAJADeviceExec, since
+// RAJA::seq_exec is the only other host policy and callers choosing it expect a sequential scan.
+template <typename Exec>
+struct isParallelHostScanExec : std::integral_constant<bool, !std::is_same<Exec, RAJA::seq_exec>::value> {};
+
+} // namespace detail
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // exclusive scan functionality
 
-template <typename T, typename Exec, typename Fn, typename ValueType=T>
+template <typename T, typename Exec, typename Fn, typename ValueType>
 void exclusive_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output also if in place)
                     chai::ManagedArray<T> outData, //!< [out] Output data if not in place
                     int size, //!< [in] Number of elements in input/output data
                     Fn binop, //!< [in] The operation to perform (such as addition)
                     ValueType val, //!< [in] The starting value
                     bool inPlace) { //!< [in] Whether or not to do the operations in place
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "care::exclusive_scan requires a trivially copyable type");
+
    if (size > 0) {
       if (inPlace) {
          if (!data) {
@@ -122,7 +151,12 @@ void exclusive_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output
          CHAIDataGetter<T, Exec> D {};
          ValueType * rawData = D.getRawArrayData(data);
 
-         if (inPlace) {
+         if (detail::isHostScanExec<Exec>::value) {
+            ValueType * rawOutData = inPlace ? rawData : D.getRawArrayData(outData);
+            care::detail::hostScan(rawData, rawOutData, (size_t) size, binop, (ValueType) val, false,
+                                   detail::isParallelHostScanExec<Exec>::value);
+         }
+         else if (inPlace) {
             RAJA::exclusive_scan_inplace<Exec>(RAJA::make_span(rawData, size),
                                                binop, val);
          }
@@ -136,11 +170,58 @@ void exclusive_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output
    }
 }
 
+// Same as exclusive_scan, but also writes the total (the value that would follow the last element) to scanTotal[0]. The
+// total is written by the device, so scanTotal can live in pinned memory and be read on the host without a pick.
+template <typename T, typename Exec, typename Fn, typename ValueType=T>
+void exclusive_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output also if in place)
+                    chai::ManagedArray<T> outData, //!< [out] Output data if not in place
+                    int size, //!< [in] Number of elements in input/output data
+                    Fn binop, //!< [in] The operation to perform (such as addition)
+                    ValueType val, //!< [in] The starting value
+                    bool inPlace, //!< [in] Whether or not to do the operations in place
+                    chai::ManagedArray<T> scanTotal) { //!< [out] Gets the total
+   if (!scanTotal) {
+      printf("[CARE] Warning: Invalid arguments to care::exclusive_scan. scanTotal cannot be nullptr.\n");
+      return;
+   }
+
+   if (size <= 0) {
+      CARE_LOOP(Exec{}, i, 0, 1) {
+         scanTotal[i] = (T) val;
+      } CARE_LOOP_END
+
+      return;
+   }
+
+   if (inPlace) {
+      // An in place scan overwrites the last element, so save it first
+      CARE_LOOP(Exec{}, i, size - 1, size) {
+         scanTotal[0] = data[i];
+      } CARE_LOOP_END
+
+      exclusive_scan<T, Exec, Fn, ValueType>(data, outData, size, binop, val, inPlace);
+
+      CARE_LOOP(Exec{}, i, size - 1, size) {
+         scanTotal[0] = (T) binop(data[i], scanTotal[0]);
+      } CARE_LOOP_END
+   }
+   else {
+      exclusive_scan<T, Exec, Fn, ValueType>(data, outData, size, binop, val, inPlace);
+
+      CARE_LOOP(Exec{}, i, size - 1, size) {
+         scanTotal[0] = (T) binop(outData[i], data[i]);
+      } CARE_LOOP_END
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // inclusive scan functionality
-template <typename T, typename Exec, typename Fn, typename ValueType=T>
+template <typename T, typename Exec, typename Fn, typename ValueType>
 void inclusive_scan(chai::ManagedArray<T> data, chai::ManagedArray<T> outData,
                     int size, Fn binop, bool inPlace) {
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "care::inclusive_scan requires a trivially copyable type");
+
    if (size > 0) {
       if (inPlace) {
          if (!data) {
@@ -210,7 +291,14 @@ void inclusive_scan(chai::ManagedArray<T> data, chai::ManagedArray<T> outData,
    CHAIDataGetter<T, Exec> D {};
    ValueType * rawData = D.getRawArrayData(data);
 
-   if (inPlace) {
+   if (detail::isHostScanExec<Exec>::value) {
+      if (size > 0) {
+         ValueType * rawOutData = inPlace ? rawData : D.getRawArrayData(outData);
+         care::detail::hostScan(rawData, rawOutData, (size_t) size, binop, ValueType(), true,
+                                detail::isParallelHostScanExec<Exec>::value);
+      }
+   }
+   else if (inPlace) {
       RAJA::inclusive_scan_inplace<Exec>(RAJA::make_span(rawData, size),
                                          binop);
    }
@@ -222,8 +310,178 @@ void inclusive_scan(chai::ManagedArray<T> data, chai::ManagedArray<T> outData,
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// segmented scan functionality
+
+namespace detail {
+
+// The number of elements each loop iteration of a device segmented scan reads. Chunks are kept small so that
+// neighboring threads read nearby elements.
+constexpr int segmentedScanChunkSize = 16;
+
+// Device version of the segmented scan. Each loop iteration reduces the part of one chunk after its last head, those
+// tails are scanned by a recursive segmented scan (a chunk with a head starts a new segment) into the carry out of each
+// chunk, and then each chunk is scanned starting from the carry out of the chunk before it. Everything stays on the
+// device, and each level of the recursion is segmentedScanChunkSize times shorter. rawData may be rawOutData.
+template <typename Exec, typename ValueType, typename Fn>
+void deviceSegmentedScan(const ValueType * rawData, ValueType * rawOutData, const bool * rawFlags, int size,
+                         Fn binop, ValueType val, bool inclusive) {
+   const int chunkSize = segmentedScanChunkSize;
+   const int numChunks = (size + chunkSize - 1) / chunkSize;
+
+   care::host_device_ptr<ValueType> carries(numChunks, "segmented_scan carries");
+   care::host_device_ptr<bool> hasHead(numChunks, "segmented_scan hasHead");
+
+   CHAIDataGetter<ValueType, Exec> carriesGetter {};
+   CHAIDataGetter<bool, Exec> hasHeadGetter {};
+   ValueType * rawCarries = carriesGetter.getRawArrayData(carries);
+   bool * rawHasHead = hasHeadGetter.getRawArrayData(hasHead);
+
+   CARE_LOOP(Exec{}, c, 0, numChunks) {
+      const int begin = c * chunkSize;
+      const int end = care::min(begin + chunkSize, size);
+      ValueType sum = rawData[begin];
+      bool head = begin == 0 || rawFlags[begin];
+
+      for (int i = begin + 1; i < end; ++i) {
+         if (rawFlags[i]) {
+            sum = rawData[i];
+            head = true;
+         }
+         else {
+            sum = binop(sum, rawData[i]);
+         }
+      }
+
+      rawCarries[c] = sum;
+      rawHasHead[c] = head;
+   } CARE_LOOP_END
+
+   // The carry out of chunk c is the inclusive segmented scan of the tails up to c
+   if (numChunks > 1) {
+      deviceSegmentedScan<Exec>((const ValueType *) rawCarries, rawCarries, (const bool *) rawHasHead, numChunks,
+                                binop, val, true);
+   }
+
+   CARE_LOOP(Exec{}, c, 0, numChunks) {
+      const int begin = c * chunkSize;
+      const int end = care::min(begin + chunkSize, size);
+
+      // Chunk 0 always starts with a head, so nothing carries into it
+      if (inclusive) {
+         ValueType running = c == 0 ? rawData[0] : rawCarries[c - 1];
+
+         for (int i = begin; i < end; ++i) {
+            running = i == 0 || rawFlags[i] ? rawData[i] : binop(running, rawData[i]);
+            rawOutData[i] = running;
+         }
+      }
+      else {
+         ValueType running = c == 0 ? val : binop(val, rawCarries[c - 1]);
+
+         for (int i = begin; i < end; ++i) {
+            const ValueType value = rawData[i];
+
+            if (i == 0 || rawFlags[i]) {
+               running = val;
+            }
+
+            rawOutData[i] = running;
+            running = binop(running, value);
+         }
+      }
+   } CARE_LOOP_END
+
+   hasHead.free();
+   carries.free();
+}
+
+} // namespace detail
+
+template <typename T, typename Exec, typename Fn, typename ValueType=T>
+void segmented_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output also if in place)
+                    chai::ManagedArray<T> outData, //!< [out] Output data if not in place
+                    int size, //!< [in] Number of elements in input/output data
+                    chai::ManagedArray<const bool> headFlags, //!< [in] True for the first element of each segment
+                    Fn binop, //!< [in] The operation to perform (such as addition)
+                    ValueType val, //!< [in] The starting value of each segment (exclusive scans only)
+                    bool inclusive, //!< [in] Whether or not each element is included in its own result
+                    bool inPlace) { //!< [in] Whether or not to do the operations in place
+   if (size <= 0) {
+      return;
+   }
+   else if (inPlace && !data) {
+      printf("[CARE] Warning: Invalid arguments to care::segmented_scan. If inPlace is true, data cannot be nullptr.\n");
+      return;
+   }
+   else if (!inPlace && (!data || !outData)) {
+      printf("[CARE] Warning: Invalid arguments to care::segmented_scan. If inPlace is false, data and outData cannot be nullptr.\n");
+      return;
+   }
+   else if (!headFlags) {
+      printf("[CARE] Warning: Invalid arguments to care::segmented_scan. headFlags cannot be nullptr.\n");
+      return;
+   }
+
+   CHAIDataGetter<T, Exec> D {};
+   CHAIDataGetter<bool, Exec> F {};
+   ValueType * rawData = D.getRawArrayData(data);
+   ValueType * rawOutData = inPlace ? rawData : D.getRawArrayData(outData);
+   const bool * rawFlags = F.getRawArrayData(*reinterpret_cast<chai::ManagedArray<bool> *>(&headFlags));
+
+   if (detail::isHostScanExec<Exec>::value) {
+      care::detail::hostSegmentedScan(rawData, rawOutData, (size_t) size,
+                                      [=] (size_t i) { return rawFlags[i]; },
+                                      binop, val, inclusive, detail::isParallelHostScanExec<Exec>::value);
+   }
+   else {
+      detail::deviceSegmentedScan<Exec>((const ValueType *) rawData, rawOutData, rawFlags, size,
+                                        binop, val, inclusive);
+   }
+}
+
+template <typename T, typename Exec, typename Fn, typename ValueType=T>
+void segmented_scan(chai::ManagedArray<T> data, //!< [in/out] Input data (output also if in place)
+                    chai::ManagedArray<T> outData, //!< [out] Output data if not in place
+                    int size, //!< [in] Number of elements in input/output data
+                    chai::ManagedArray<const int> offsets, //!< [in] The first element of each segment
+                    int numSegments, //!< [in] Number of entries in offsets used
+                    Fn binop, //!< [in] The operation to perform (such as addition)
+                    ValueType val, //!< [in] The starting value of each segment (exclusive scans only)
+                    bool inclusive, //!< [in] Whether or not each element is included in its own result
+                    bool inPlace) { //!< [in] Whether or not to do the operations in place
+   if (size <= 0) {
+      return;
+   }
+   else if (numSegments > 0 && !offsets) {
+      printf("[CARE] Warning: Invalid arguments to care::segmented_scan. If numSegments > 0, offsets cannot be nullptr.\n");
+      return;
+   }
+
+   // Turn the offsets into head flags
+   care::host_device_ptr<bool> headFlags(size, "segmented_scan headFlags");
+
+   CARE_LOOP(Exec{}, i, 0, size) {
+      headFlags[i] = false;
+   } CARE_LOOP_END
+
+   CARE_LOOP(Exec{}, s, 0, numSegments) {
+      const int head = offsets[s];
+
+      if (0 <= head && head < size) {
+         headFlags[head] = true;
+      }
+   } CARE_LOOP_END
+
+   segmented_scan<T, Exec, Fn, ValueType>(data, outData, size, headFlags, binop, val, inclusive, inPlace);
+
+   headFlags.free();
+}
+
 #endif // defined(_CARE_SCAN_INST_H_)
 
+#ifdef CARE_SCAN_EXEC
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Function implementations
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -246,6 +504,14 @@ void exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const int> inData, chai::
     exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<int> *>(&inData), outData, size, val, inPlace);
 }
 
+// scan that also writes the total to scanTotal
+void exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                    int size, int val, bool inPlace, chai::ManagedArray<int> scanTotal)
+{
+   exclusive_scan<int, CARE_SCAN_EXEC, RAJA::operators::plus<int>>(data, outData, size,
+                                                                   RAJA::operators::plus<int>{}, val, inPlace, scanTotal) ;
+}
+
 void exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
                     int size, float val, bool inPlace)
 {
@@ -293,6 +559,14 @@ void exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, ch
     exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<GIDTYPE> *>(&inData), outData, size, val, inPlace);
 }
 
+// scan that also writes the total to scanTotal
+void exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                    int size, GIDTYPE val, bool inPlace, chai::ManagedArray<GIDTYPE> scanTotal)
+{
+   exclusive_scan<GIDTYPE, CARE_SCAN_EXEC, RAJA::operators::plus<GIDTYPE>, GIDTYPE>(data, outData, size,
+                                                                                    RAJA::operators::plus<GIDTYPE>{}, val, inPlace, scanTotal) ;
+}
+
 #endif // CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -362,7 +636,271 @@ void inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, ch
 
 #endif // CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
 
-} // namespace care
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// segmented scan functionality
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val, bool inPlace)
+{
+   segmented_scan<int, CARE_SCAN_EXEC, RAJA::operators::plus<int>>(data, outData, size, headFlags,
+                                                                   RAJA::operators::plus<int>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, int val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<int> *>(&inData), outData, size,
+                              headFlags, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace)
+{
+   segmented_scan<int, CARE_SCAN_EXEC, RAJA::operators::plus<int>>(data, outData, size, headFlags,
+                                                                   RAJA::operators::plus<int>{}, (int) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const bool> headFlags)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<int> *>(&inData), outData, size,
+                              headFlags, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val, bool inPlace)
+{
+   segmented_scan<int, CARE_SCAN_EXEC, RAJA::operators::plus<int>>(data, outData, size, offsets, numSegments,
+                                                                   RAJA::operators::plus<int>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, int val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<int> *>(&inData), outData, size,
+                              offsets, numSegments, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<int> data, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace)
+{
+   segmented_scan<int, CARE_SCAN_EXEC, RAJA::operators::plus<int>>(data, outData, size, offsets, numSegments,
+                                                                   RAJA::operators::plus<int>{}, (int) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const int> inData, chai::ManagedArray<int> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<int> *>(&inData), outData, size,
+                              offsets, numSegments, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val, bool inPlace)
+{
+   segmented_scan<float, CARE_SCAN_EXEC, RAJA::operators::plus<float>>(data, outData, size, headFlags,
+                                                                       RAJA::operators::plus<float>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, float val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<float> *>(&inData), outData, size,
+                              headFlags, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace)
+{
+   segmented_scan<float, CARE_SCAN_EXEC, RAJA::operators::plus<float>>(data, outData, size, headFlags,
+                                                                       RAJA::operators::plus<float>{}, (float) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const bool> headFlags)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<float> *>(&inData), outData, size,
+                              headFlags, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val, bool inPlace)
+{
+   segmented_scan<float, CARE_SCAN_EXEC, RAJA::operators::plus<float>>(data, outData, size, offsets, numSegments,
+                                                                       RAJA::operators::plus<float>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, float val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<float> *>(&inData), outData, size,
+                              offsets, numSegments, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<float> data, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace)
+{
+   segmented_scan<float, CARE_SCAN_EXEC, RAJA::operators::plus<float>>(data, outData, size, offsets, numSegments,
+                                                                       RAJA::operators::plus<float>{}, (float) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const float> inData, chai::ManagedArray<float> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<float> *>(&inData), outData, size,
+                              offsets, numSegments, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val, bool inPlace)
+{
+   segmented_scan<double, CARE_SCAN_EXEC, RAJA::operators::plus<double>>(data, outData, size, headFlags,
+                                                                         RAJA::operators::plus<double>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, double val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<double> *>(&inData), outData, size,
+                              headFlags, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace)
+{
+   segmented_scan<double, CARE_SCAN_EXEC, RAJA::operators::plus<double>>(data, outData, size, headFlags,
+                                                                         RAJA::operators::plus<double>{}, (double) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const bool> headFlags)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<double> *>(&inData), outData, size,
+                              headFlags, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val, bool inPlace)
+{
+   segmented_scan<double, CARE_SCAN_EXEC, RAJA::operators::plus<double>>(data, outData, size, offsets, numSegments,
+                                                                         RAJA::operators::plus<double>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, double val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<double> *>(&inData), outData, size,
+                              offsets, numSegments, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<double> data, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace)
+{
+   segmented_scan<double, CARE_SCAN_EXEC, RAJA::operators::plus<double>>(data, outData, size, offsets, numSegments,
+                                                                         RAJA::operators::plus<double>{}, (double) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const double> inData, chai::ManagedArray<double> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<double> *>(&inData), outData, size,
+                              offsets, numSegments, inPlace);
+}
+
+#if CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val, bool inPlace)
+{
+   segmented_scan<GIDTYPE, CARE_SCAN_EXEC, RAJA::operators::plus<GIDTYPE>, GIDTYPE>(data, outData, size, headFlags,
+                                                                                    RAJA::operators::plus<GIDTYPE>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, GIDTYPE val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<GIDTYPE> *>(&inData), outData, size,
+                              headFlags, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags, bool inPlace)
+{
+   segmented_scan<GIDTYPE, CARE_SCAN_EXEC, RAJA::operators::plus<GIDTYPE>, GIDTYPE>(data, outData, size, headFlags,
+                                                                                    RAJA::operators::plus<GIDTYPE>{}, (GIDTYPE) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const bool> headFlags)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<GIDTYPE> *>(&inData), outData, size,
+                              headFlags, inPlace);
+}
+
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val, bool inPlace)
+{
+   segmented_scan<GIDTYPE, CARE_SCAN_EXEC, RAJA::operators::plus<GIDTYPE>, GIDTYPE>(data, outData, size, offsets, numSegments,
+                                                                                    RAJA::operators::plus<GIDTYPE>{}, val, false, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_exclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, GIDTYPE val)
+{
+   const bool inPlace = false;
+   segmented_exclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<GIDTYPE> *>(&inData), outData, size,
+                              offsets, numSegments, val, inPlace);
+}
+
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<GIDTYPE> data, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments, bool inPlace)
+{
+   segmented_scan<GIDTYPE, CARE_SCAN_EXEC, RAJA::operators::plus<GIDTYPE>, GIDTYPE>(data, outData, size, offsets, numSegments,
+                                                                                    RAJA::operators::plus<GIDTYPE>{}, (GIDTYPE) 0, true, inPlace);
+}
+
+// typesafe wrapper for out of place scan
+void segmented_inclusive_scan(CARE_SCAN_EXEC, chai::ManagedArray<const GIDTYPE> inData, chai::ManagedArray<GIDTYPE> outData,
+                              int size, chai::ManagedArray<const int> offsets, int numSegments)
+{
+   const bool inPlace = false;
+   segmented_inclusive_scan(CARE_SCAN_EXEC{}, *reinterpret_cast<chai::ManagedArray<GIDTYPE> *>(&inData), outData, size,
+                              offsets, numSegments, inPlace);
+}
+
+#endif // CARE_HAVE_LLNL_GLOBALID && GLOBALID_IS_64BIT
 
 #undef CARE_SCAN_EXEC
 
+#endif // defined(CARE_SCAN_EXEC)
+
+} // namespace care
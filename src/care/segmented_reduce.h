@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_SEGMENTED_REDUCE_H_
+#define _CARE_SEGMENTED_REDUCE_H_
+
+// This header reduces every segment of a CSR style array (values plus
+// offsets) in a few load balanced passes, however skewed the segment
+// lengths are. It is used by the Segmented* algorithms and by
+// KeyValueSorter::reduceByKey. The reduction is templated on the
+// operation, so it is defined here rather than being instantiated in
+// care_inst.h.
+
+// CARE config header
+#include "care/config.h"
+
+// CARE headers
+#include "care/DefaultMacros.h"
+#include "care/host_device_ptr.h"
+#include "care/policies.h"
+#include "care/algorithm_decl.h"
+
+namespace care {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////
+/// A SegmentedReduce operation that combines values with a binary
+/// operator, such as RAJA::operators::plus
+///////////////////////////////////////////////////////////////////////////
+template <typename T, typename BinaryOp>
+struct SegmentedBinaryOp {
+   CARE_HOST_DEVICE static T lift(const care::host_device_ptr<const T>& values, int i) {
+      return values[i];
+   }
+
+   CARE_HOST_DEVICE static T combine(const care::host_device_ptr<const T>&, T left, T right) {
+      return BinaryOp{}(left, right);
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// The number of values each iteration of SegmentedReduce handles.
+/// Sequentially there is nothing to balance, so the whole range is one
+/// tile. GPU threads get short tiles so there are enough of them to fill
+/// the device.
+///////////////////////////////////////////////////////////////////////////
+inline int segmentedTileSize(RAJA::seq_exec, int length)
+{
+   return length > 0 ? length : 1;
+}
+
+template <typename Exec>
+inline int segmentedTileSize(Exec, int)
+{
+#if defined(CARE_GPUCC)
+   return 64;
+#else
+   return 2048;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Reduces each segment of values described by offsets into
+///        results. The values are cut into equal sized tiles that ignore
+///        segment boundaries. The first pass reduces every piece of a
+///        segment within a tile: the first piece of each tile is written
+///        to heads, and every later piece starts its segment and is
+///        written to results. The tiles whose first element falls in
+///        segment s are a contiguous range, so the heads are reduced per
+///        segment by applying SegmentedReduce to them in turn, which
+///        shrinks the problem by the tile size at every level. Finally
+///        each segment combines its own piece with the reduction of its
+///        heads. No iteration handles more than one tile, whatever the
+///        segment lengths.
+///        Op provides lift(values, i), the partial result of element i,
+///        and combine(values, left, right), where left always comes from
+///        earlier in the segment.
+/// @param[in]  values      - The values to reduce
+/// @param[in]  offsets     - The numSegments+1 segment boundaries
+/// @param[in]  numSegments - The number of segments
+/// @param[out] results     - The reduction of each segment
+/// @param[in]  identity    - The result of an empty segment
+/// @param[in]  partials    - If given, element i is partials[i] rather
+///                           than Op::lift(values, i)
+/// @return void
+///////////////////////////////////////////////////////////////////////////
+template <typename Op, typename T, typename ResultType, typename Exec>
+inline void SegmentedReduce(Exec,
+                            care::host_device_ptr<const T> values,
+                            care::host_device_ptr<int const> offsets,
+                            int numSegments,
+                            care::host_device_ptr<ResultType> results,
+                            const ResultType identity,
+                            care::host_device_ptr<const ResultType> partials = nullptr)
+{
+   if (numSegments <= 0) {
+      return;
+   }
+
+   const int first = offsets.pick(0);
+   const int last = offsets.pick(numSegments);
+
+   if (last <= first) {
+      CARE_LOOP(Exec{}, s, 0, numSegments) {
+         results[s] = identity;
+      } CARE_LOOP_END
+
+      return;
+   }
+
+   const int tileSize = segmentedTileSize(Exec{}, last - first);
+   const int numTiles = (last - first + tileSize - 1) / tileSize;
+   const bool fromPartials = (bool) partials;
+
+   care::host_device_ptr<ResultType> heads(numTiles, "SegmentedReduce heads");
+
+   CARE_LOOP(Exec{}, t, 0, numTiles) {
+      const int tileBegin = first + t * tileSize;
+      const int tileEnd = care::min(tileBegin + tileSize, last);
+
+      // The segment holding tileBegin is the last one starting at or
+      // before it, which skips any empty segments
+      int low = 0;
+      int high = numSegments - 1;
+
+      while (low < high) {
+         const int mid = (low + high + 1) / 2;
+
+         if (offsets[mid] <= tileBegin) {
+            low = mid;
+         }
+         else {
+            high = mid - 1;
+         }
+      }
+
+      int s = low;
+      int i = tileBegin;
+
+      while (i < tileEnd) {
+         const int pieceEnd = care::min(offsets[s + 1], tileEnd);
+         ResultType partial = fromPartials ? partials[i] : Op::lift(values, i);
+
+         for (int j = i + 1; j < pieceEnd; ++j) {
+            partial = Op::combine(values, partial, fromPartials ? partials[j] : Op::lift(values, j));
+         }
+
+         if (i == tileBegin) {
+            heads[t] = partial;
+         }
+         else {
+            results[s] = partial;
+         }
+
+         i = pieceEnd;
+
+         // Move on to the next nonempty segment
+         do {
+            ++s;
+         } while (s < numSegments && offsets[s + 1] <= i);
+      }
+   } CARE_LOOP_END
+
+   // The heads of segment s are those of the tiles starting in it
+   care::host_device_ptr<int> headOffsets(numSegments + 1, "SegmentedReduce headOffsets");
+
+   CARE_LOOP(Exec{}, s, 0, numSegments + 1) {
+      headOffsets[s] = (offsets[s] - first + tileSize - 1) / tileSize;
+   } CARE_LOOP_END
+
+   // With a single tile each segment has at most one head
+   care::host_device_ptr<ResultType> headResults;
+
+   if (numTiles > 1) {
+      headResults = care::host_device_ptr<ResultType>(numSegments, "SegmentedReduce headResults");
+      SegmentedReduce<Op>(Exec{}, values, care::host_device_ptr<int const>(headOffsets), numSegments,
+                          headResults, identity, care::host_device_ptr<const ResultType>(heads));
+   }
+
+   CARE_LOOP(Exec{}, s, 0, numSegments) {
+      const int begin = offsets[s];
+      const int firstHead = headOffsets[s];
+
+      if (begin == offsets[s + 1]) {
+         results[s] = identity;
+      }
+      else if (firstHead < headOffsets[s + 1]) {
+         const ResultType fromHeads = numTiles > 1 ? headResults[s] : heads[firstHead];
+
+         // A segment starting on a tile boundary has no piece of its own
+         if ((begin - first) % tileSize == 0) {
+            results[s] = fromHeads;
+         }
+         else {
+            results[s] = Op::combine(values, results[s], fromHeads);
+         }
+      }
+   } CARE_LOOP_END
+
+   if (headResults) {
+      headResults.free();
+   }
+
+   headOffsets.free();
+   heads.free();
+}
+
+} // namespace detail
+} // namespace care
+
+#endif // !defined(_CARE_SEGMENTED_REDUCE_H_)
+
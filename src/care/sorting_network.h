@@ -0,0 +1,182 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CARE_SORTING_NETWORK_H_
+#define _CARE_SORTING_NETWORK_H_
+
+// This header contains sorting networks for short arrays whose length is known
+// at compile time. A sorting network is a fixed sequence of compare-exchange
+// operations, so it has no data dependent branches (each compare-exchange
+// becomes a min and a max) and every thread in a warp does the same work.
+// The networks are Batcher's odd-even merge sort, generated by template
+// recursion for the next power of two and pruned of every comparator that
+// would touch an element past the end of the array.
+
+// CARE config header
+#include "care/config.h"
+
+// Other CARE headers
+#include "care/GPUMacros.h"
+
+namespace care {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////
+/// The longest runtime length that sortLocal handles with a sorting
+/// network. Longer compile time lengths are supported by sortLocal<N>.
+///////////////////////////////////////////////////////////////////////////
+constexpr int maxSortingNetworkSize = 16;
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Orders a pair of elements without branching.
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+CARE_HOST_DEVICE inline void compareExchange(T& a, T& b)
+{
+   const bool swap = b < a;
+   const T low = swap ? b : a;
+   const T high = swap ? a : b;
+   a = low;
+   b = high;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// The smallest power of two greater than or equal to N
+///////////////////////////////////////////////////////////////////////////
+template <int N, int P = 1, bool Done = (P >= N)>
+struct NextPowerOfTwo {
+   static constexpr int value = NextPowerOfTwo<N, 2 * P>::value;
+};
+
+template <int N, int P>
+struct NextPowerOfTwo<N, P, true> {
+   static constexpr int value = P;
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// A single comparator of the network, dropped if J is past the end of
+/// the array (the missing elements act as +infinity and never move).
+///////////////////////////////////////////////////////////////////////////
+template <int N, int I, int J, bool InRange = (J < N)>
+struct NetworkComparator {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T* array) {
+      compareExchange(array[I], array[J]);
+   }
+};
+
+template <int N, int I, int J>
+struct NetworkComparator<N, I, J, false> {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T*) {}
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// The comparators (I, I+R), (I+M, I+M+R), ... that finish a merge step
+///////////////////////////////////////////////////////////////////////////
+template <int N, int I, int End, int R, int M, bool Continue = (I + R < End)>
+struct NetworkMergeComparators {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T* array) {
+      NetworkComparator<N, I, I + R>::apply(array);
+      NetworkMergeComparators<N, I + M, End, R, M>::apply(array);
+   }
+};
+
+template <int N, int I, int End, int R, int M>
+struct NetworkMergeComparators<N, I, End, R, M, false> {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T*) {}
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// Merges the two sorted halves of the Count elements at Lo, looking only
+/// at every R-th element
+///////////////////////////////////////////////////////////////////////////
+template <int N, int Lo, int Count, int R, bool Recurse = (2 * R < Count)>
+struct NetworkMerge {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T* array) {
+      NetworkMerge<N, Lo, Count, 2 * R>::apply(array);
+      NetworkMerge<N, Lo + R, Count, 2 * R>::apply(array);
+      NetworkMergeComparators<N, Lo + R, Lo + Count, R, 2 * R>::apply(array);
+   }
+};
+
+template <int N, int Lo, int Count, int R>
+struct NetworkMerge<N, Lo, Count, R, false> {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T* array) {
+      NetworkComparator<N, Lo, Lo + R>::apply(array);
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// Sorts the Count (a power of two) elements at Lo. Blocks that lie
+/// entirely past the end of the array are skipped.
+///////////////////////////////////////////////////////////////////////////
+template <int N, int Lo, int Count, bool Active = (Count > 1 && Lo < N)>
+struct NetworkSort {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T* array) {
+      NetworkSort<N, Lo, Count / 2>::apply(array);
+      NetworkSort<N, Lo + Count / 2, Count / 2>::apply(array);
+      NetworkMerge<N, Lo, Count, 1>::apply(array);
+   }
+};
+
+template <int N, int Lo, int Count>
+struct NetworkSort<N, Lo, Count, false> {
+   template <typename T>
+   CARE_HOST_DEVICE static inline void apply(T*) {}
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sorts the first N elements of array in ascending order with a
+///        sorting network.
+///////////////////////////////////////////////////////////////////////////
+template <int N, typename T>
+CARE_HOST_DEVICE inline void sortingNetwork(T* array)
+{
+   NetworkSort<N, 0, NextPowerOfTwo<N>::value>::apply(array);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Sorts the first len elements of array with the sorting network
+///        for that length.
+/// @return false if len is longer than maxSortingNetworkSize, in which
+///         case array is left unchanged
+///////////////////////////////////////////////////////////////////////////
+template <typename T>
+CARE_HOST_DEVICE inline bool sortingNetwork(T* array, const int len)
+{
+   switch (len) {
+      case 0:
+      case 1:  return true;
+      case 2:  sortingNetwork<2>(array);  return true;
+      case 3:  sortingNetwork<3>(array);  return true;
+      case 4:  sortingNetwork<4>(array);  return true;
+      case 5:  sortingNetwork<5>(array);  return true;
+      case 6:  sortingNetwork<6>(array);  return true;
+      case 7:  sortingNetwork<7>(array);  return true;
+      case 8:  sortingNetwork<8>(array);  return true;
+      case 9:  sortingNetwork<9>(array);  return true;
+      case 10: sortingNetwork<10>(array); return true;
+      case 11: sortingNetwork<11>(array); return true;
+      case 12: sortingNetwork<12>(array); return true;
+      case 13: sortingNetwork<13>(array); return true;
+      case 14: sortingNetwork<14>(array); return true;
+      case 15: sortingNetwork<15>(array); return true;
+      case 16: sortingNetwork<16>(array); return true;
+      default: return false;
+   }
+}
+
+} // namespace detail
+} // namespace care
+
+#endif // !defined(_CARE_SORTING_NETWORK_H_)
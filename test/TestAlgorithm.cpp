@@ -14,6 +14,13 @@
 // CARE headers
 #include "care/algorithm.h"
 #include "care/detail/test_utils.h"
+#include "care/host_algorithm.h"
+
+// Std library headers
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 
 
@@ -157,6 +164,50 @@ TEST(algorithm, checkSorted) {
   ASSERT_FALSE(result);
 }
 
+TEST(algorithm, sortingnetwork)
+{
+   // By the zero-one principle, a network that sorts every sequence of
+   // zeros and ones sorts everything
+   for (int len = 0; len <= care::detail::maxSortingNetworkSize; ++len) {
+      for (int bits = 0; bits < (1 << len); ++bits) {
+         int a[care::detail::maxSortingNetworkSize];
+
+         for (int i = 0; i < len; ++i) {
+            a[i] = (bits >> i) & 1;
+         }
+
+         care::sortLocal(care::local_ptr<int>(a), len);
+         EXPECT_TRUE(std::is_sorted(a, a + len));
+      }
+   }
+
+   // Compile time lengths, including ones that are not a power of two
+   double b[32];
+   double expected[32];
+
+   for (int i = 0; i < 32; ++i) {
+      b[i] = expected[i] = (double) ((i * 7919) % 23) - 11.5;
+   }
+
+   std::sort(expected, expected + 32);
+   care::sortLocal<32>(care::local_ptr<double>(b));
+
+   for (int i = 0; i < 32; ++i) {
+      EXPECT_EQ(b[i], expected[i]);
+   }
+
+   for (int i = 0; i < 27; ++i) {
+      b[i] = expected[i] = (double) ((i * 7919) % 13);
+   }
+
+   std::sort(expected, expected + 27);
+   care::sortLocal<27>(care::local_ptr<double>(b));
+
+   for (int i = 0; i < 27; ++i) {
+      EXPECT_EQ(b[i], expected[i]);
+   }
+}
+
 TEST(algorithm, binarysearch) {
    int* nil = nullptr;
    int  a[7] = {-9, 0, 3, 7, 77, 500, 999}; // sorted no duplicates
@@ -206,6 +257,56 @@ TEST(algorithm, binarysearch) {
    EXPECT_EQ(result, -1);
 }
 
+TEST(algorithm, binarysearchbatch) {
+   const int mapSize = 7;
+   const int numQueries = 9;
+   int b[mapSize] = {0, 1, 1, 1, 1, 1, 6};       // sorted with duplicates
+   int q[numQueries] = {-3, 0, 1, 1, 2, 5, 6, 6, 9}; // sorted queries
+
+   care::host_device_ptr<int> map(mapSize, "map");
+   care::host_device_ptr<int> queries(numQueries, "queries");
+   care::host_device_ptr<int> results(numQueries, "results");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, mapSize) {
+      map[i] = b[i];
+   } CARE_SEQUENTIAL_LOOP_END
+
+   CARE_SEQUENTIAL_LOOP(i, 0, numQueries) {
+      queries[i] = q[i];
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Every combination of upper bound, sorted fast path, and a nonzero start
+   // should agree with BinarySearch. When there are duplicates,
+   // BinarySearch may return any of them, so compare the values found.
+   for (int start = 0; start < 3; ++start) {
+      for (bool returnUpperBound : {false, true}) {
+         for (bool queriesSorted : {false, true}) {
+            care::BinarySearchBatch<int>(RAJA::seq_exec(), map, start, mapSize - start,
+                                         queries, numQueries, results,
+                                         returnUpperBound, queriesSorted);
+
+            CARE_SEQUENTIAL_LOOP(i, 0, numQueries) {
+               const int expected = care::BinarySearch<int>(b, start, mapSize - start, q[i], returnUpperBound);
+
+               if (expected == -1 || returnUpperBound) {
+                  EXPECT_EQ(results[i], expected);
+               }
+               else {
+                  ASSERT_GE(results[i], start);
+                  EXPECT_EQ(b[results[i]], b[expected]);
+               }
+
+               EXPECT_EQ(results[i], care::BranchlessBinarySearch<int>(b, start, mapSize - start, q[i], returnUpperBound));
+            } CARE_SEQUENTIAL_LOOP_END
+         }
+      }
+   }
+
+   results.free();
+   queries.free();
+   map.free();
+}
+
 TEST(algorithm, intersectarrays) {
    int tempa[3] = {1, 2, 5};
    int tempb[5] = {2, 3, 4, 5, 6};
@@ -256,6 +357,118 @@ TEST(algorithm, intersectarrays) {
    EXPECT_EQ(numMatches[0], 0);
 }
 
+TEST(algorithm, intersectarrays_gallop) {
+   // The second array is much longer than the first, so the intersection
+   // gallops through it instead of doing a linear merge
+   const int size1 = 4;
+   const int size2 = 200;
+   int tempa[size1] = {-5, 6, 7, 398};
+   int tempb[size2];
+
+   for (int i = 0; i < size2; ++i) {
+      tempb[i] = 2 * i;
+   }
+
+   care::host_ptr<int> a(tempa);
+   care::host_ptr<int> b(tempb);
+   care::host_ptr<int> matches1, matches2;
+   int numMatches[1] = {77};
+
+   care::IntersectArrays<int>(RAJA::seq_exec(), a, size1, 0, b, size2, 0, matches1, matches2, numMatches);
+   EXPECT_EQ(numMatches[0], 2);
+   EXPECT_EQ(matches1[0], 1);
+   EXPECT_EQ(matches1[1], 3);
+   EXPECT_EQ(matches2[0], 3);
+   EXPECT_EQ(matches2[1], 199);
+
+   std::free(matches1.data());
+   std::free(matches2.data());
+
+   // Same thing with the arguments swapped
+   care::IntersectArrays<int>(RAJA::seq_exec(), b, size2, 0, a, size1, 0, matches1, matches2, numMatches);
+   EXPECT_EQ(numMatches[0], 2);
+   EXPECT_EQ(matches1[0], 3);
+   EXPECT_EQ(matches1[1], 199);
+   EXPECT_EQ(matches2[0], 1);
+   EXPECT_EQ(matches2[1], 3);
+
+   std::free(matches1.data());
+   std::free(matches2.data());
+}
+
+TEST(algorithm, setoperations) {
+   // Multiples of 2 from index 1 and multiples of 3, long enough to span
+   // several tiles of the merge
+   const int size1 = 1000;
+   const int size2 = 700;
+   care::host_device_ptr<int> a(size1 + 1, "a");
+   care::host_device_ptr<int> b(size2, "b");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size1 + 1) {
+      a[i] = 2 * i - 2;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size2) {
+      b[i] = 3 * i;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   std::vector<int> hostA, hostB;
+
+   for (int i = 0; i < size1; ++i) {
+      hostA.push_back(2 * i);
+   }
+
+   for (int i = 0; i < size2; ++i) {
+      hostB.push_back(3 * i);
+   }
+
+   std::vector<int> expectedUnion, expectedDifference, expectedSymmetric;
+   std::set_union(hostA.begin(), hostA.end(), hostB.begin(), hostB.end(), std::back_inserter(expectedUnion));
+   std::set_difference(hostA.begin(), hostA.end(), hostB.begin(), hostB.end(), std::back_inserter(expectedDifference));
+   std::set_symmetric_difference(hostA.begin(), hostA.end(), hostB.begin(), hostB.end(), std::back_inserter(expectedSymmetric));
+
+   care::host_device_ptr<int> result;
+   int resultSize = -1;
+
+   auto checkResult = [&] (const std::vector<int>& expected) {
+      ASSERT_EQ(resultSize, (int) expected.size());
+
+      care::host_ptr<int> hostResult = result;
+
+      for (int i = 0; i < resultSize; ++i) {
+         EXPECT_EQ(hostResult[i], expected[i]);
+      }
+
+      result.free();
+   };
+
+   care::UnionArrays<int>(RAJA::seq_exec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedUnion);
+
+   care::DifferenceArrays<int>(RAJA::seq_exec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedDifference);
+
+   care::SymmetricDifferenceArrays<int>(RAJA::seq_exec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedSymmetric);
+
+   care::UnionArrays<int>(RAJAExec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedUnion);
+
+   care::DifferenceArrays<int>(RAJAExec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedDifference);
+
+   care::SymmetricDifferenceArrays<int>(RAJAExec(), a, size1, 1, b, size2, 0, result, &resultSize);
+   checkResult(expectedSymmetric);
+
+   // Removing an array from itself leaves nothing
+   care::DifferenceArrays<int>(RAJAExec(), b, size2, 0, b, size2, 0, result, &resultSize);
+   EXPECT_EQ(resultSize, 0);
+   EXPECT_EQ(result, care::host_device_ptr<int>(nullptr));
+
+   b.free();
+   a.free();
+}
+
 TEST(algorithm, compressarray)
 {
    // Test CompressArray with removed list mode
@@ -308,6 +521,728 @@ TEST(algorithm, compressarray)
    mapList.free();
 }
 
+TEST(algorithm, arraystats)
+{
+   const int size = 7;
+   care::host_device_ptr<int> a(size, "a");
+   care::host_device_ptr<int> mask(size, "mask");
+   care::host_device_ptr<int> subset(3, "subset");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+      a[0] = 4;
+      a[1] = -2;
+      a[2] = 9;
+      a[3] = 0;
+      a[4] = 7;
+      a[5] = -5;
+      a[6] = 3;
+
+      // Entries are skipped where the mask is nonzero
+      mask[0] = 0;
+      mask[1] = 0;
+      mask[2] = 1;
+      mask[3] = 0;
+      mask[4] = 0;
+      mask[5] = 1;
+      mask[6] = 0;
+
+      subset[0] = 6;
+      subset[1] = 2;
+      subset[2] = 1;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   care::ArrayStatistics<int> stats = care::ArrayStats<int, int, RAJA::seq_exec>(a, size);
+   EXPECT_EQ(stats.min, -5);
+   EXPECT_EQ(stats.max, 9);
+   EXPECT_EQ(stats.sum, 16);
+   EXPECT_EQ(stats.count, 7);
+   EXPECT_EQ(stats.minLoc, 5);
+   EXPECT_EQ(stats.maxLoc, 2);
+
+   stats = care::ArrayStatsSubset<int, int, RAJA::seq_exec>(a, subset, 3);
+   EXPECT_EQ(stats.min, -2);
+   EXPECT_EQ(stats.max, 9);
+   EXPECT_EQ(stats.sum, 10);
+   EXPECT_EQ(stats.count, 3);
+   EXPECT_EQ(stats.minLoc, 1);
+   EXPECT_EQ(stats.maxLoc, 2);
+
+   stats = care::ArrayMaskedStats<int, int, RAJA::seq_exec>(a, mask, size);
+   EXPECT_EQ(stats.min, -2);
+   EXPECT_EQ(stats.max, 7);
+   EXPECT_EQ(stats.sum, 12);
+   EXPECT_EQ(stats.count, 5);
+   EXPECT_EQ(stats.minLoc, 1);
+   EXPECT_EQ(stats.maxLoc, 4);
+
+   stats = care::ArrayMaskedStatsSubset<int, int, RAJA::seq_exec>(a, mask, subset, 3);
+   EXPECT_EQ(stats.min, -2);
+   EXPECT_EQ(stats.max, 3);
+   EXPECT_EQ(stats.sum, 1);
+   EXPECT_EQ(stats.count, 2);
+   EXPECT_EQ(stats.minLoc, 1);
+   EXPECT_EQ(stats.maxLoc, 6);
+
+   // empty
+   stats = care::ArrayStats<int, int, RAJA::seq_exec>(a, 0);
+   EXPECT_EQ(stats.count, 0);
+   EXPECT_EQ(stats.sum, 0);
+   EXPECT_EQ(stats.minLoc, -1);
+   EXPECT_EQ(stats.maxLoc, -1);
+
+   subset.free();
+   mask.free();
+   a.free();
+}
+
+TEST(algorithm, parallelsort)
+{
+   // Large enough to take the threaded path when OpenMP is enabled
+   const int size = 100003;
+   std::vector<int> a(size);
+
+   for (int i = 0; i < size; ++i) {
+      a[i] = (i * 7919) % 1000;
+   }
+
+   std::vector<int> expected(a);
+   std::sort(expected.begin(), expected.end());
+
+   care::detail::parallelSort(a.data(), size);
+   EXPECT_EQ(a, expected);
+
+   // Stable sort of pairs by first element only
+   std::vector<std::pair<int, int>> b(size);
+
+   for (int i = 0; i < size; ++i) {
+      b[i] = std::make_pair((i * 7919) % 100, i);
+   }
+
+   auto compareFirst = [] (const std::pair<int, int>& left, const std::pair<int, int>& right) {
+      return left.first < right.first;
+   };
+
+   std::vector<std::pair<int, int>> expectedPairs(b);
+   std::stable_sort(expectedPairs.begin(), expectedPairs.end(), compareFirst);
+
+   care::detail::parallelSort(b.data(), size, compareFirst, true);
+   EXPECT_EQ(b, expectedPairs);
+}
+
+TEST(algorithm, radixsort)
+{
+   // Large enough to take the radix path, with negative values
+   const int size = 100003;
+   std::vector<int> a(size);
+
+   for (int i = 0; i < size; ++i) {
+      a[i] = ((i * 7919) % 200003) - 100000;
+   }
+
+   a[0] = std::numeric_limits<int>::min();
+   a[1] = std::numeric_limits<int>::max();
+
+   std::vector<int> expected(a);
+   std::sort(expected.begin(), expected.end());
+
+   std::vector<int> b(a);
+   care::detail::hostSort(b.data(), size, false);
+   EXPECT_EQ(b, expected);
+
+   care::detail::hostSort(a.data(), size, true);
+   EXPECT_EQ(a, expected);
+
+   // 64 bit keys in a small range only need one pass
+   std::vector<long long> c(size);
+
+   for (int i = 0; i < size; ++i) {
+      c[i] = (1LL << 40) + (i * 7919) % 97;
+   }
+
+   std::vector<long long> expectedLong(c);
+   std::sort(expectedLong.begin(), expectedLong.end());
+
+   care::detail::radixSort(c.data(), size, true);
+   EXPECT_EQ(c, expectedLong);
+
+   // Stable sort of pairs by first element only
+   std::vector<std::pair<int, int>> d(size);
+
+   for (int i = 0; i < size; ++i) {
+      d[i] = std::make_pair((i * 7919) % 1000 - 500, i);
+   }
+
+   auto compareFirst = [] (const std::pair<int, int>& left, const std::pair<int, int>& right) {
+      return left.first < right.first;
+   };
+
+   auto keyOfFirst = [] (const std::pair<int, int>& pair) {
+      return pair.first;
+   };
+
+   std::vector<std::pair<int, int>> expectedPairs(d);
+   std::stable_sort(expectedPairs.begin(), expectedPairs.end(), compareFirst);
+
+   care::detail::hostStableSortByKey(d.data(), size, keyOfFirst, compareFirst, true);
+   EXPECT_EQ(d, expectedPairs);
+}
+
+TEST(algorithm, selection)
+{
+   // Long enough for the OpenMP versions to use threads, with many ties
+   const int len = 100000;
+   const int ks[4] = {0, 1, 37, len + 5};
+
+   std::vector<int> original(len);
+
+   for (int i = 0; i < len; ++i) {
+      original[i] = (i * 7919) % 1013;
+   }
+
+   std::vector<int> sorted(original);
+   std::sort(sorted.begin(), sorted.end());
+
+   care::host_device_ptr<int> a(len, "a");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      for (int k : ks) {
+         const int numSelected = std::min(k, len);
+
+         // TopK
+         std::copy(original.begin(), original.end(), care::host_ptr<int>(a).data());
+
+         care::host_device_ptr<int> values;
+         care::host_device_ptr<int> indices;
+
+         if (pass == 0) {
+            care::TopK<int>(RAJA::seq_exec{}, a, len, k, values, indices);
+         }
+         else {
+            care::TopK<int>(RAJAExec{}, a, len, k, values, indices);
+         }
+
+         if (numSelected == 0) {
+            EXPECT_EQ(values, care::host_device_ptr<int>(nullptr));
+            EXPECT_EQ(indices, care::host_device_ptr<int>(nullptr));
+         }
+         else {
+            const int * hostValues = care::host_ptr<const int>(values).cdata();
+            const int * hostIndices = care::host_ptr<const int>(indices).cdata();
+
+            for (int i = 0; i < numSelected; ++i) {
+               EXPECT_EQ(hostValues[i], sorted[i]);
+               EXPECT_EQ(original[hostIndices[i]], hostValues[i]);
+
+               if (i > 0 && hostValues[i] == hostValues[i - 1]) {
+                  EXPECT_LT(hostIndices[i - 1], hostIndices[i]);
+               }
+            }
+
+            values.free();
+            indices.free();
+         }
+
+         // PartialSort
+         if (pass == 0) {
+            care::PartialSort<int>(RAJA::seq_exec{}, a, len, k);
+         }
+         else {
+            care::PartialSort<int>(RAJAExec{}, a, len, k);
+         }
+
+         std::vector<int> result(care::host_ptr<const int>(a).cdata(), care::host_ptr<const int>(a).cdata() + len);
+
+         for (int i = 0; i < numSelected; ++i) {
+            EXPECT_EQ(result[i], sorted[i]);
+         }
+
+         std::sort(result.begin(), result.end());
+         EXPECT_EQ(result, sorted);
+
+         // NthElement
+         const int n = numSelected < len ? numSelected : len - 1;
+
+         std::copy(original.begin(), original.end(), care::host_ptr<int>(a).data());
+
+         if (pass == 0) {
+            care::NthElement<int>(RAJA::seq_exec{}, a, len, n);
+         }
+         else {
+            care::NthElement<int>(RAJAExec{}, a, len, n);
+         }
+
+         const int * hostA = care::host_ptr<const int>(a).cdata();
+
+         EXPECT_EQ(hostA[n], sorted[n]);
+
+         for (int i = 0; i < n; ++i) {
+            EXPECT_LE(hostA[i], hostA[n]);
+         }
+
+         for (int i = n + 1; i < len; ++i) {
+            EXPECT_GE(hostA[i], hostA[n]);
+         }
+      }
+   }
+
+   a.free();
+}
+
+TEST(algorithm, streamcompaction)
+{
+   // Large enough for the parallel path, with runs of repeated values
+   const int size = 100003;
+   care::host_device_ptr<int> a(size, "a");
+   care::host_device_ptr<int> b(size, "b");
+   std::vector<int> expected;
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size) {
+      a[i] = i / 3 + (i % 7 == 0 ? 1 : 0);
+      b[i] = a[i];
+   } CARE_SEQUENTIAL_LOOP_END
+
+   care::host_ptr<int> hostA = a;
+   std::unique_copy(hostA.data(), hostA.data() + size, std::back_inserter(expected));
+
+   // Out of place and in place uniq
+   care::host_device_ptr<int> c;
+   int cLen = 0;
+   care::uniqArray(RAJAExec(), a, size, c, cLen);
+   const int bLen = care::uniqArray(RAJAExec(), b, size, true);
+
+   ASSERT_EQ(cLen, (int) expected.size());
+   ASSERT_EQ(bLen, (int) expected.size());
+
+   CARE_SEQUENTIAL_LOOP(i, 0, cLen) {
+      EXPECT_EQ(c[i], expected[i]);
+      EXPECT_EQ(b[i], expected[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Remove every third element
+   const int removedLen = (size + 2) / 3;
+   care::host_device_ptr<int> removed(removedLen, "removed");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size) {
+      a[i] = i;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   CARE_SEQUENTIAL_LOOP(i, 0, removedLen) {
+      removed[i] = 3 * i;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   care::CompressArray<int>(RAJAExec(), a, size, removed, removedLen, care::compress_array::removed_list, true);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size - removedLen) {
+      EXPECT_EQ(a[i], 3 * (i / 2) + 1 + i % 2);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   removed.free();
+   c.free();
+   b.free();
+   a.free();
+}
+
+TEST(algorithm, segmentedreductions)
+{
+   // Highly skewed segment lengths, including empty segments at both ends
+   // and one segment spanning many tiles
+   const int numSegments = 8;
+   const int lengths[numSegments] = {0, 3, 1, 0, 10000, 2, 5000, 0};
+
+   care::host_device_ptr<int> offsets(numSegments + 1, "offsets");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+      offsets[0] = 0;
+
+      for (int k = 0; k < numSegments; ++k) {
+         offsets[k + 1] = offsets[k] + lengths[k];
+      }
+   } CARE_SEQUENTIAL_LOOP_END
+
+   const int total = offsets.pick(numSegments);
+
+   care::host_device_ptr<int> values(total, "values");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, total) {
+      values[i] = (i * 7919) % 1013 - 500;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   care::host_device_ptr<int> sums(numSegments, "sums");
+   care::host_device_ptr<int> mins(numSegments, "mins");
+   care::host_device_ptr<int> maxs(numSegments, "maxs");
+   care::host_device_ptr<int> locs(numSegments, "locs");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      if (pass == 0) {
+         care::SegmentedSum<int, int, RAJA::seq_exec>(values, offsets, numSegments, sums);
+         care::SegmentedMin<int, RAJA::seq_exec>(values, offsets, numSegments, mins);
+         care::SegmentedMax<int, RAJA::seq_exec>(values, offsets, numSegments, maxs);
+         care::SegmentedArgMin<int, RAJA::seq_exec>(values, offsets, numSegments, locs);
+      }
+      else {
+         care::SegmentedSum<int>(values, offsets, numSegments, sums);
+         care::SegmentedMin<int>(values, offsets, numSegments, mins);
+         care::SegmentedMax<int>(values, offsets, numSegments, maxs);
+         care::SegmentedArgMin<int>(values, offsets, numSegments, locs);
+      }
+
+      CARE_SEQUENTIAL_LOOP(s, 0, numSegments) {
+         int sum = 0;
+         int min = std::numeric_limits<int>::max();
+         int max = std::numeric_limits<int>::lowest();
+         int loc = -1;
+
+         for (int i = offsets[s]; i < offsets[s + 1]; ++i) {
+            sum += values[i];
+            max = values[i] > max ? values[i] : max;
+
+            if (values[i] < min) {
+               min = values[i];
+               loc = i;
+            }
+         }
+
+         EXPECT_EQ(sums[s], sum);
+         EXPECT_EQ(mins[s], min);
+         EXPECT_EQ(maxs[s], max);
+         EXPECT_EQ(locs[s], loc);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   locs.free();
+   maxs.free();
+   mins.free();
+   sums.free();
+   values.free();
+   offsets.free();
+}
+
+TEST(algorithm, histogram)
+{
+   // Long enough for the OpenMP versions to use threads, with values
+   // outside of the bins on both sides
+   const int n = 100000;
+
+   care::host_device_ptr<int> keys(n, "keys");
+   care::host_device_ptr<double> values(n, "values");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      keys[i] = (i * 7919) % 23 - 3;
+      values[i] = 0.5 * keys[i];
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Few bins are privatized on the device, many bins are not
+   const int binCounts[2] = {7, 1000};
+
+   for (int nbins : binCounts) {
+      std::vector<int> expectedKeys(nbins, 0);
+      std::vector<int> expectedValues(nbins, 0);
+
+      for (int i = 0; i < n; ++i) {
+         const int key = (i * 7919) % 23 - 3;
+
+         if (0 <= key && key < nbins) {
+            ++expectedKeys[key];
+         }
+
+         // Values in [0, 5) with bins of width 5 / nbins
+         const double value = 0.5 * key;
+
+         if (0.0 <= value && value < 5.0) {
+            ++expectedValues[std::min((int) (value * (nbins / 5.0)), nbins - 1)];
+         }
+      }
+
+      care::host_device_ptr<int> counts(nbins, "counts");
+      care::host_device_ptr<int> offsets(nbins + 1, "offsets");
+
+      for (int pass = 0; pass < 2; ++pass) {
+         if (pass == 0) {
+            care::BinCount<RAJA::seq_exec>(keys, n, nbins, counts, offsets);
+         }
+         else {
+            care::BinCount(keys, n, nbins, counts, offsets);
+         }
+
+         CARE_SEQUENTIAL_LOOP(b, 0, nbins) {
+            EXPECT_EQ(counts[b], expectedKeys[b]);
+         } CARE_SEQUENTIAL_LOOP_END
+
+         int sum = 0;
+
+         CARE_SEQUENTIAL_LOOP(b, 0, nbins + 1) {
+            EXPECT_EQ(offsets[b], sum);
+
+            if (b < nbins) {
+               sum += expectedKeys[b];
+            }
+         } CARE_SEQUENTIAL_LOOP_END
+
+         if (pass == 0) {
+            care::Histogram<double, RAJA::seq_exec>(values, n, nbins, 0.0, 5.0, counts);
+         }
+         else {
+            care::Histogram<double>(values, n, nbins, 0.0, 5.0, counts);
+         }
+
+         CARE_SEQUENTIAL_LOOP(b, 0, nbins) {
+            EXPECT_EQ(counts[b], expectedValues[b]);
+         } CARE_SEQUENTIAL_LOOP_END
+      }
+
+      offsets.free();
+      counts.free();
+   }
+
+   values.free();
+   keys.free();
+}
+
+// A value with its index, scanned by keeping the smallest value
+struct ValueAndIndex {
+   int value;
+   int index;
+};
+
+struct MinValueAndIndex {
+   CARE_HOST_DEVICE ValueAndIndex operator()(const ValueAndIndex& a, const ValueAndIndex& b) const {
+      return b.value < a.value ? b : a;
+   }
+};
+
+TEST(algorithm, genericscan)
+{
+   // Long enough for the OpenMP versions to use threads
+   const int n = 300001;
+
+   care::host_device_ptr<int> values(n, "values");
+   care::host_device_ptr<int> maxs(n, "maxs");
+   care::host_device_ptr<size_t> sizes(n, "sizes");
+   care::host_device_ptr<ValueAndIndex> mins(n, "mins");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         values[i] = (int) (((long long) i * 7919) % 100003);
+         sizes[i] = (size_t) 1 << 20;
+         mins[i] = ValueAndIndex{values[i], i};
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (pass == 0) {
+         care::InclusiveScan<int, RAJA::seq_exec>(values, maxs, n, RAJA::operators::maximum<int>{});
+         care::ExclusiveScan<size_t, RAJA::seq_exec>(sizes, sizes, n, RAJA::operators::plus<size_t>{}, (size_t) 0);
+         care::InclusiveScan<ValueAndIndex, RAJA::seq_exec>(mins, mins, n, MinValueAndIndex{});
+      }
+      else {
+         care::InclusiveScan<int>(values, maxs, n, RAJA::operators::maximum<int>{});
+         care::ExclusiveScan<size_t>(sizes, sizes, n, RAJA::operators::plus<size_t>{}, (size_t) 0);
+         care::InclusiveScan<ValueAndIndex>(mins, mins, n, MinValueAndIndex{});
+      }
+
+      CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+         int max = values[0];
+         ValueAndIndex min {values[0], 0};
+
+         for (int j = 0; j < n; ++j) {
+            max = std::max(max, values[j]);
+
+            if (values[j] < min.value) {
+               min = ValueAndIndex{values[j], j};
+            }
+
+            EXPECT_EQ(maxs[j], max);
+            EXPECT_EQ(sizes[j], ((size_t) j) << 20);
+            EXPECT_EQ(mins[j].value, min.value);
+            EXPECT_EQ(mins[j].index, min.index);
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   mins.free();
+   sizes.free();
+   maxs.free();
+   values.free();
+}
+
+TEST(algorithm, sortsegments)
+{
+   // A mix of empty, tiny, medium and long segments
+   const int numSegments = 6;
+   const int lengths[numSegments] = {5, 0, 1, 300, 12, 70000};
+
+   care::host_device_ptr<int> offsets(numSegments + 1, "offsets");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+      offsets[0] = 0;
+
+      for (int k = 0; k < numSegments; ++k) {
+         offsets[k + 1] = offsets[k] + lengths[k];
+      }
+   } CARE_SEQUENTIAL_LOOP_END
+
+   const int total = offsets.pick(numSegments);
+
+   care::host_device_ptr<int> a(total, "a");
+   care::host_device_ptr<int> newLengths(numSegments, "newLengths");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      CARE_SEQUENTIAL_LOOP(i, 0, total) {
+         a[i] = (i * 7919) % 97;
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (pass == 0) {
+         care::sortSegments(RAJA::seq_exec{}, a, offsets, numSegments);
+      }
+      else {
+         care::sortSegments(RAJAExec{}, a, offsets, numSegments);
+      }
+
+      CARE_SEQUENTIAL_LOOP(s, 0, numSegments) {
+         std::vector<int> expected;
+
+         for (int i = offsets[s]; i < offsets[s + 1]; ++i) {
+            expected.push_back((i * 7919) % 97);
+         }
+
+         std::sort(expected.begin(), expected.end());
+
+         for (int i = offsets[s]; i < offsets[s + 1]; ++i) {
+            EXPECT_EQ(a[i], expected[i - offsets[s]]);
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (pass == 0) {
+         care::uniqSegments(RAJA::seq_exec{}, a, offsets, numSegments, newLengths);
+      }
+      else {
+         care::uniqSegments(RAJAExec{}, a, offsets, numSegments, newLengths);
+      }
+
+      CARE_SEQUENTIAL_LOOP(s, 0, numSegments) {
+         std::vector<int> expected;
+
+         for (int i = offsets[s]; i < offsets[s + 1]; ++i) {
+            expected.push_back((i * 7919) % 97);
+         }
+
+         std::sort(expected.begin(), expected.end());
+         expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+         EXPECT_EQ(newLengths[s], (int) expected.size());
+
+         for (int k = 0; k < newLengths[s]; ++k) {
+            EXPECT_EQ(a[offsets[s] + k], expected[k]);
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   newLengths.free();
+   a.free();
+   offsets.free();
+}
+
+TEST(algorithm, mergesorted)
+{
+   // Sorted runs with duplicates within and across runs, including an
+   // empty run and one long enough to be split across threads
+   const int numRuns = 5;
+   const int lengths[numRuns] = {7, 0, 40000, 1, 300};
+
+   care::host_device_ptr<int> offsets(numRuns + 1, "offsets");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+      offsets[0] = 0;
+
+      for (int r = 0; r < numRuns; ++r) {
+         offsets[r + 1] = offsets[r] + lengths[r];
+      }
+   } CARE_SEQUENTIAL_LOOP_END
+
+   const int total = offsets.pick(numRuns);
+
+   care::host_device_ptr<int> a(total, "a");
+   std::vector<care::host_device_ptr<int>> ownedRuns;
+   std::vector<care::host_device_ptr<const int>> runs;
+   std::vector<int> runLengths;
+   std::vector<int> expected;
+
+   for (int r = 0; r < numRuns; ++r) {
+      care::host_device_ptr<int> run(lengths[r], "run");
+
+      CARE_SEQUENTIAL_LOOP(i, 0, lengths[r]) {
+         run[i] = (i * (r + 1)) / 3;
+         a[offsets[r] + i] = run[i];
+      } CARE_SEQUENTIAL_LOOP_END
+
+      for (int i = 0; i < lengths[r]; ++i) {
+         expected.push_back((i * (r + 1)) / 3);
+      }
+
+      ownedRuns.push_back(run);
+      runs.push_back(run);
+      runLengths.push_back(lengths[r]);
+   }
+
+   std::sort(expected.begin(), expected.end());
+
+   std::vector<int> expectedUniq(expected);
+   expectedUniq.erase(std::unique(expectedUniq.begin(), expectedUniq.end()), expectedUniq.end());
+
+   for (int pass = 0; pass < 8; ++pass) {
+      const bool parallel = pass & 1;
+      const bool uniq = pass & 2;
+      const bool segments = pass & 4;
+
+      care::host_device_ptr<int> result;
+      int resultLen = -1;
+
+      if (segments) {
+         if (parallel) {
+            care::MergeSorted<int>(RAJAExec{}, a, offsets, numRuns, result, resultLen, uniq);
+         }
+         else {
+            care::MergeSorted<int>(RAJA::seq_exec{}, a, offsets, numRuns, result, resultLen, uniq);
+         }
+      }
+      else {
+         if (parallel) {
+            care::MergeSorted<int>(RAJAExec{}, runs, runLengths, result, resultLen, uniq);
+         }
+         else {
+            care::MergeSorted<int>(RAJA::seq_exec{}, runs, runLengths, result, resultLen, uniq);
+         }
+      }
+
+      const std::vector<int> & answer = uniq ? expectedUniq : expected;
+
+      ASSERT_EQ(resultLen, (int) answer.size());
+
+      const int * hostResult = care::host_ptr<const int>(result).cdata();
+
+      for (int i = 0; i < resultLen; ++i) {
+         EXPECT_EQ(hostResult[i], answer[i]);
+      }
+
+      result.free();
+   }
+
+   // Nothing to merge
+   care::host_device_ptr<int> result;
+   int resultLen = -1;
+
+   care::MergeSorted<int>(RAJAExec{}, std::vector<care::host_device_ptr<const int>>(), std::vector<int>(),
+                          result, resultLen, true);
+
+   EXPECT_EQ(resultLen, 0);
+   EXPECT_EQ(result, care::host_device_ptr<int>(nullptr));
+
+   for (int r = 0; r < numRuns; ++r) {
+      ownedRuns[r].free();
+   }
+
+   a.free();
+   offsets.free();
+}
+
 #if defined(CARE_GPUCC)
 
 GPU_TEST(algorithm, min_empty)
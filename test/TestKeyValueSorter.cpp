@@ -139,6 +139,124 @@ TEST(KeyValueSorter, host_device_ptr_Constructor)
    } CARE_HOST_KERNEL_END
 }
 
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Test case that checks that the sorted keys and values can be
+///        read directly and that eliminating duplicates keeps the first
+///        occurrence of each value in the original order.
+///
+/////////////////////////////////////////////////////////////////////////
+TEST(KeyValueSorter, EliminateDuplicates)
+{
+   int length = 8;
+   int data[8] = {5, 2, 5, 7, 2, 2, 9, 7};
+   care::KeyValueSorter<size_t, int, RAJA::seq_exec> sorter(length, data);
+
+   sorter.sort();
+
+   care::host_ptr<const size_t> keys = sorter.keys();
+   care::host_ptr<const int> values = sorter.values();
+
+   EXPECT_EQ(keys[0], 1);
+   EXPECT_EQ(keys[1], 4);
+   EXPECT_EQ(keys[2], 5);
+   EXPECT_EQ(values[0], 2);
+   EXPECT_EQ(values[7], 9);
+
+   sorter.sortByKey();
+   sorter.eliminateDuplicates();
+
+   ASSERT_EQ(sorter.len(), 4);
+
+   CARE_HOST_KERNEL {
+      EXPECT_EQ(sorter.key(0), 0);
+      EXPECT_EQ(sorter.key(1), 1);
+      EXPECT_EQ(sorter.key(2), 3);
+      EXPECT_EQ(sorter.key(3), 6);
+
+      EXPECT_EQ(sorter.value(0), 5);
+      EXPECT_EQ(sorter.value(1), 2);
+      EXPECT_EQ(sorter.value(2), 7);
+      EXPECT_EQ(sorter.value(3), 9);
+   } CARE_HOST_KERNEL_END
+}
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Test case that checks that reduceByKey combines the values of
+///        equal keys and uniqueByKey keeps the first value of each key.
+///
+/////////////////////////////////////////////////////////////////////////
+TEST(KeyValueSorter, ReduceByKey)
+{
+   int length = 8;
+   int keys[8] = {3, 1, 3, 0, 1, 3, 7, 0};
+   int data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+   care::KeyValueSorter<int, int, RAJA::seq_exec> sums(length);
+   care::KeyValueSorter<int, int, RAJA::seq_exec> firsts(length);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, length) {
+      sums.setKey(i, keys[i]);
+      sums.setValue(i, data[i]);
+      firsts.setKey(i, keys[i]);
+      firsts.setValue(i, data[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   sums.reduceByKey(RAJA::operators::plus<int>{});
+   firsts.uniqueByKey();
+
+   ASSERT_EQ(sums.len(), 4);
+   ASSERT_EQ(firsts.len(), 4);
+
+   CARE_HOST_KERNEL {
+      EXPECT_EQ(sums.key(0), 0);
+      EXPECT_EQ(sums.key(1), 1);
+      EXPECT_EQ(sums.key(2), 3);
+      EXPECT_EQ(sums.key(3), 7);
+
+      EXPECT_EQ(sums.value(0), 12);
+      EXPECT_EQ(sums.value(1), 7);
+      EXPECT_EQ(sums.value(2), 10);
+      EXPECT_EQ(sums.value(3), 7);
+
+      EXPECT_EQ(firsts.key(2), 3);
+
+      EXPECT_EQ(firsts.value(0), 4);
+      EXPECT_EQ(firsts.value(1), 2);
+      EXPECT_EQ(firsts.value(2), 1);
+      EXPECT_EQ(firsts.value(3), 7);
+   } CARE_HOST_KERNEL_END
+}
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Test case that checks that argsort produces the sorting
+///        permutation in the keys and leaves the values alone.
+///
+/////////////////////////////////////////////////////////////////////////
+TEST(KeyValueSorter, Argsort)
+{
+   int length = 6;
+   int data[6] = {4, 1, 4, 0, 3, 1};
+   care::KeyValueSorter<size_t, int, RAJA::seq_exec> sorter(length, data);
+
+   sorter.argsort();
+
+   CARE_HOST_KERNEL {
+      EXPECT_EQ(sorter.key(0), 3);
+      EXPECT_EQ(sorter.key(1), 1);
+      EXPECT_EQ(sorter.key(2), 5);
+      EXPECT_EQ(sorter.key(3), 4);
+      EXPECT_EQ(sorter.key(4), 0);
+      EXPECT_EQ(sorter.key(5), 2);
+   } CARE_HOST_KERNEL_END
+
+   CARE_SEQUENTIAL_LOOP(i, 0, length) {
+      EXPECT_EQ(sorter.value(i), data[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+}
+
 #if defined(CARE_GPUCC)
 
 /////////////////////////////////////////////////////////////////////////
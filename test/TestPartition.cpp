@@ -0,0 +1,324 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "care/config.h"
+
+// other library headers
+#include "gtest/gtest.h"
+
+// care headers
+#include "care/partition.h"
+#include "care/detail/test_utils.h"
+
+// Std library headers
+#include <vector>
+
+#if defined(CARE_GPUCC)
+GPU_TEST(forall, Initialization) {
+   printf("Initializing\n");
+   init_care_for_testing();
+   printf("Initialized... Testing care::StablePartition\n");
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Predicate and bucket functions for the tests
+///
+/////////////////////////////////////////////////////////////////////////
+struct IsMultipleOfThree {
+   CARE_HOST_DEVICE bool operator()(const int value) const {
+      return value % 3 == 0;
+   }
+};
+
+struct LastDigit {
+   CARE_HOST_DEVICE int operator()(const int value) const {
+      return value % 10;
+   }
+};
+
+struct SquareOf {
+   CARE_HOST_DEVICE double operator()(const int i) const {
+      return (double) i * i;
+   }
+};
+
+struct IsOddIndex {
+   CARE_HOST_DEVICE bool operator()(const int i) const {
+      return i % 2 == 1;
+   }
+};
+
+struct KeepAll {
+   CARE_HOST_DEVICE bool operator()(const int) const {
+      return true;
+   }
+};
+
+struct KeepNone {
+   CARE_HOST_DEVICE bool operator()(const int) const {
+      return false;
+   }
+};
+
+// Long enough for the OpenMP versions to use threads
+static const int partitionTestSize = 100000;
+
+CARE_HOST_DEVICE static int partitionTestValue(const int i)
+{
+   return (i * 7919) % 100003;
+}
+
+TEST(partition, predicate)
+{
+   const int n = partitionTestSize;
+   care::host_device_ptr<int> a(n, "a");
+
+   std::vector<int> expected;
+
+   for (int i = 0; i < n; ++i) {
+      if (partitionTestValue(i) % 3 == 0) {
+         expected.push_back(partitionTestValue(i));
+      }
+   }
+
+   const int numTrue = (int) expected.size();
+
+   for (int i = 0; i < n; ++i) {
+      if (partitionTestValue(i) % 3 != 0) {
+         expected.push_back(partitionTestValue(i));
+      }
+   }
+
+   for (int pass = 0; pass < 2; ++pass) {
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         a[i] = partitionTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      int split;
+
+      if (pass == 0) {
+         split = care::StablePartition(RAJA::seq_exec{}, a, n, IsMultipleOfThree{});
+      }
+      else {
+         split = care::StablePartition(a, n, IsMultipleOfThree{});
+      }
+
+      EXPECT_EQ(split, numTrue);
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         EXPECT_EQ(a[i], expected[i]);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   EXPECT_EQ(care::StablePartition(a, 0, IsMultipleOfThree{}), 0);
+
+   a.free();
+}
+
+TEST(partition, flags)
+{
+   const int n = 1000;
+   care::host_device_ptr<double> a(n, "a");
+   care::host_device_ptr<int> flags(n, "flags");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      a[i] = 0.5 * i;
+      flags[i] = (i / 7) % 2;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   const int split = care::StablePartitionByFlags(a, n, flags);
+
+   EXPECT_EQ(split, 497);
+
+   std::vector<double> expected;
+
+   for (int pass = 1; pass >= 0; --pass) {
+      for (int i = 0; i < n; ++i) {
+         if ((i / 7) % 2 == pass) {
+            expected.push_back(0.5 * i);
+         }
+      }
+   }
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      EXPECT_EQ(a[i], expected[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   flags.free();
+   a.free();
+}
+
+TEST(partition, multiway)
+{
+   const int n = partitionTestSize;
+   const int numBuckets = 10;
+
+   care::host_device_ptr<int> a(n, "a");
+   care::host_device_ptr<int> offsets(numBuckets + 1, "offsets");
+
+   std::vector<int> expected;
+   std::vector<int> expectedOffsets;
+
+   for (int b = 0; b < numBuckets; ++b) {
+      expectedOffsets.push_back((int) expected.size());
+
+      for (int i = 0; i < n; ++i) {
+         if (partitionTestValue(i) % 10 == b) {
+            expected.push_back(partitionTestValue(i));
+         }
+      }
+   }
+
+   expectedOffsets.push_back(n);
+
+   for (int pass = 0; pass < 2; ++pass) {
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         a[i] = partitionTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (pass == 0) {
+         care::MultiwayPartition(RAJA::seq_exec{}, a, n, numBuckets, LastDigit{}, offsets);
+      }
+      else {
+         care::MultiwayPartition(a, n, numBuckets, LastDigit{}, offsets);
+      }
+
+      CARE_SEQUENTIAL_LOOP(b, 0, numBuckets + 1) {
+         EXPECT_EQ(offsets[b], expectedOffsets[b]);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         EXPECT_EQ(a[i], expected[i]);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   offsets.free();
+   a.free();
+}
+
+TEST(partition, copyif)
+{
+   const int n = partitionTestSize;
+   care::host_device_ptr<int> a(n, "a");
+   care::host_device_ptr<int> out(n, "out");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      a[i] = partitionTestValue(i);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   std::vector<int> expected;
+
+   for (int i = 0; i < n; ++i) {
+      if (partitionTestValue(i) % 3 == 0) {
+         expected.push_back(partitionTestValue(i));
+      }
+   }
+
+   const care::host_device_ptr<const int> in = a;
+
+   for (int pass = 0; pass < 2; ++pass) {
+      int count = 0;
+
+      if (pass == 0) {
+         count = care::CopyIf(RAJA::seq_exec{}, in, n, out, IsMultipleOfThree{});
+      }
+      else {
+         count = care::CopyIf(in, n, out, IsMultipleOfThree{});
+      }
+
+      ASSERT_EQ(count, (int) expected.size());
+
+      CARE_SEQUENTIAL_LOOP(i, 0, count) {
+         EXPECT_EQ(out[i], expected[i]);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   // Nothing kept
+   EXPECT_EQ(care::CopyIf(in, 0, out, IsMultipleOfThree{}), 0);
+
+   out.free();
+   a.free();
+}
+
+TEST(partition, transformcopyif)
+{
+   const int n = partitionTestSize;
+   care::host_device_ptr<double> out(n / 2, "out");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      int count = 0;
+
+      if (pass == 0) {
+         count = care::TransformCopyIf(RAJA::seq_exec{}, n, out, SquareOf{}, IsOddIndex{});
+      }
+      else {
+         count = care::TransformCopyIf(n, out, SquareOf{}, IsOddIndex{});
+      }
+
+      ASSERT_EQ(count, n / 2);
+
+      CARE_SEQUENTIAL_LOOP(k, 0, count) {
+         EXPECT_EQ(out[k], (double) (2 * k + 1) * (2 * k + 1));
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   out.free();
+}
+
+TEST(partition, copyiftiles)
+{
+   // care::detail::copyIfTileSize, which is only defined for the device
+   const int tileSize = 16;
+
+   // Shorter than a tile, not a multiple of the tile size, and long enough
+   // for the OpenMP versions to use threads
+   const int sizes[] = {tileSize / 2 + 1, 100 * tileSize + 7, partitionTestSize};
+
+   care::host_device_ptr<int> a(partitionTestSize, "a");
+   care::host_device_ptr<int> out(partitionTestSize, "out");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, partitionTestSize) {
+      a[i] = partitionTestValue(i);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   const care::host_device_ptr<const int> in = a;
+
+   for (const int n : sizes) {
+      std::vector<int> expected;
+
+      for (int i = 0; i < n; ++i) {
+         if (partitionTestValue(i) % 3 == 0) {
+            expected.push_back(partitionTestValue(i));
+         }
+      }
+
+      const int count = care::CopyIf(in, n, out, IsMultipleOfThree{});
+
+      ASSERT_EQ(count, (int) expected.size());
+
+      CARE_SEQUENTIAL_LOOP(i, 0, count) {
+         EXPECT_EQ(out[i], expected[i]);
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   // Everything kept
+   const int numKept = care::CopyIf(in, partitionTestSize, out, KeepAll{});
+
+   ASSERT_EQ(numKept, partitionTestSize);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, partitionTestSize) {
+      EXPECT_EQ(out[i], partitionTestValue(i));
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Nothing kept
+   EXPECT_EQ(care::CopyIf(in, partitionTestSize, out, KeepNone{}), 0);
+
+   out.free();
+   a.free();
+}
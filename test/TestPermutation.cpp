@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "care/config.h"
+
+// other library headers
+#include "gtest/gtest.h"
+
+// care headers
+#include "care/permutation.h"
+#include "care/detail/test_utils.h"
+
+#if defined(CARE_GPUCC)
+GPU_TEST(forall, Initialization) {
+   printf("Initializing\n");
+   init_care_for_testing();
+   printf("Initialized... Testing care::ApplyPermutation\n");
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Fills a permutation with cycles of several lengths, plus fixed
+///        points, and arrays of different types to permute.
+///
+/////////////////////////////////////////////////////////////////////////
+static void fillPermutationTest(const int n, care::host_device_ptr<int> perm,
+                                care::host_device_ptr<int> ints,
+                                care::host_device_ptr<double> doubles)
+{
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      // Reverse each block of 7 elements (the last block is shorter)
+      const int block = i / 7 * 7;
+      const int end = block + 7 < n ? block + 7 : n;
+      perm[i] = block + (end - 1 - i);
+      ints[i] = 10 * i;
+      doubles[i] = 0.5 * i;
+   } CARE_SEQUENTIAL_LOOP_END
+}
+
+TEST(permutation, outofplace)
+{
+   const int n = 1000;
+   care::host_device_ptr<int> perm(n, "perm");
+   care::host_device_ptr<int> ints(n, "ints");
+   care::host_device_ptr<double> doubles(n, "doubles");
+
+   fillPermutationTest(n, perm, ints, doubles);
+
+   care::ApplyPermutation(RAJA::seq_exec{}, perm, n, ints, doubles);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      EXPECT_EQ(ints[i], 10 * perm[i]);
+      EXPECT_EQ(doubles[i], 0.5 * perm[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Applying the permutation again undoes it, since it is an involution
+   care::ApplyPermutation(perm, n, ints, doubles);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      EXPECT_EQ(ints[i], 10 * i);
+      EXPECT_EQ(doubles[i], 0.5 * i);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   doubles.free();
+   ints.free();
+   perm.free();
+}
+
+TEST(permutation, inplace)
+{
+   const int n = 1000;
+   care::host_device_ptr<int> perm(n, "perm");
+   care::host_device_ptr<int> ints(n, "ints");
+   care::host_device_ptr<double> doubles(n, "doubles");
+
+   fillPermutationTest(n, perm, ints, doubles);
+
+   // A rotation is a single cycle through every element
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      perm[i] = (i + 3) % n;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   care::ApplyPermutationInPlace(perm, n, ints, doubles);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      EXPECT_EQ(ints[i], 10 * ((i + 3) % n));
+      EXPECT_EQ(doubles[i], 0.5 * ((i + 3) % n));
+   } CARE_SEQUENTIAL_LOOP_END
+
+   // Many short cycles and fixed points
+   fillPermutationTest(n, perm, ints, doubles);
+
+   care::ApplyPermutationInPlace(perm, n, ints, doubles);
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      EXPECT_EQ(ints[i], 10 * perm[i]);
+      EXPECT_EQ(doubles[i], 0.5 * perm[i]);
+   } CARE_SEQUENTIAL_LOOP_END
+
+   doubles.free();
+   ints.free();
+   perm.free();
+}
+
+TEST(permutation, tilesizes)
+{
+   // A whole number of tiles, one element past them, and several tiles
+   // with a partial last one
+   const int sizes[] = {1024, 1025, 5000};
+
+   for (const int n : sizes) {
+      care::host_device_ptr<int> perm(n, "perm");
+      care::host_device_ptr<int> ints(n, "ints");
+      care::host_device_ptr<double> doubles(n, "doubles");
+
+      for (int pass = 0; pass < 2; ++pass) {
+         fillPermutationTest(n, perm, ints, doubles);
+
+         if (pass == 0) {
+            care::ApplyPermutation(RAJA::seq_exec{}, perm, n, ints, doubles);
+         }
+         else {
+            care::ApplyPermutation(perm, n, ints, doubles);
+         }
+
+         CARE_SEQUENTIAL_LOOP(i, 0, n) {
+            EXPECT_EQ(ints[i], 10 * perm[i]);
+            EXPECT_EQ(doubles[i], 0.5 * perm[i]);
+         } CARE_SEQUENTIAL_LOOP_END
+      }
+
+      // Many short cycles and fixed points
+      fillPermutationTest(n, perm, ints, doubles);
+
+      care::ApplyPermutationInPlace(perm, n, ints, doubles);
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         EXPECT_EQ(ints[i], 10 * perm[i]);
+         EXPECT_EQ(doubles[i], 0.5 * perm[i]);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      // A single cycle through every element
+      fillPermutationTest(n, perm, ints, doubles);
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         perm[i] = (i + 3) % n;
+      } CARE_SEQUENTIAL_LOOP_END
+
+      care::ApplyPermutationInPlace(perm, n, ints, doubles);
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         EXPECT_EQ(ints[i], 10 * ((i + 3) % n));
+         EXPECT_EQ(doubles[i], 0.5 * ((i + 3) % n));
+      } CARE_SEQUENTIAL_LOOP_END
+
+      doubles.free();
+      ints.free();
+      perm.free();
+   }
+}
@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "care/config.h"
+
+// other library headers
+#include "gtest/gtest.h"
+
+// care headers
+#include "care/ReductionFuser.h"
+#include "care/detail/test_utils.h"
+
+// std library headers
+#include <limits>
+
+using namespace care;
+
+TEST(ReductionFuser, empty)
+{
+   ReductionFuser<int, RAJA::seq_exec> fuser;
+   host_device_ptr<int> empty(1, "empty");
+
+   EXPECT_EQ(fuser.fusibleReduceArray(empty, 0, reduction_op::sum), 0);
+   EXPECT_EQ(fuser.fusibleReduceArray(empty, 0, reduction_op::min), 1);
+   EXPECT_EQ(fuser.fusibleReduceArray(empty, 0, reduction_op::max), 2);
+   EXPECT_EQ(fuser.size(), 3);
+
+   int results[3];
+   fuser.reduce(results);
+
+   EXPECT_EQ(results[0], 0);
+   EXPECT_EQ(results[1], std::numeric_limits<int>::max());
+   EXPECT_EQ(results[2], std::numeric_limits<int>::lowest());
+   EXPECT_EQ(fuser.size(), 0);
+
+   empty.free();
+}
+
+TEST(ReductionFuser, manyArrays)
+{
+   // Lengths that straddle the chunk size
+   const int chunk = ReductionFuser<int, RAJA::seq_exec>::chunkSize;
+   const int lengths[] = {1, 7, chunk - 1, chunk, chunk + 1, 3 * chunk + 5};
+   const int numArrays = sizeof(lengths) / sizeof(lengths[0]);
+
+   host_device_ptr<int> arrays[numArrays];
+   ReductionFuser<int, RAJA::seq_exec> fuser;
+
+   for (int a = 0; a < numArrays; ++a) {
+      const int len = lengths[a];
+      arrays[a] = host_device_ptr<int>(len, "array");
+      host_device_ptr<int> array = arrays[a];
+
+      CARE_SEQUENTIAL_LOOP(i, 0, len) {
+         array[i] = (i * 37 + a) % 101 - 50;
+      } CARE_SEQUENTIAL_LOOP_END
+
+      fuser.fusibleReduceArray(array, len, reduction_op::sum);
+      fuser.fusibleReduceArray(array, len, reduction_op::min);
+      fuser.fusibleReduceArray(array, len, reduction_op::max);
+   }
+
+   int results[3 * numArrays];
+   fuser.reduce(results);
+
+   for (int a = 0; a < numArrays; ++a) {
+      int sum = 0;
+      int min = std::numeric_limits<int>::max();
+      int max = std::numeric_limits<int>::lowest();
+
+      for (int i = 0; i < lengths[a]; ++i) {
+         const int value = (i * 37 + a) % 101 - 50;
+         sum += value;
+         min = value < min ? value : min;
+         max = value > max ? value : max;
+      }
+
+      EXPECT_EQ(results[3 * a], sum);
+      EXPECT_EQ(results[3 * a + 1], min);
+      EXPECT_EQ(results[3 * a + 2], max);
+
+      arrays[a].free();
+   }
+}
+
+#if defined(CARE_GPUCC)
+
+GPU_TEST(ReductionFuser, gpu_initialization) {
+   init_care_for_testing();
+}
+
+GPU_TEST(ReductionFuser, manyArrays)
+{
+   const int chunk = ReductionFuser<double, RAJADeviceExec>::chunkSize;
+   const int len1 = 5 * chunk + 3;
+   const int len2 = 10;
+
+   host_device_ptr<double> array1(len1, "array1");
+   host_device_ptr<double> array2(len2, "array2");
+
+   CARE_STREAM_LOOP(i, 0, len1) {
+      array1[i] = (double) (i % 17);
+   } CARE_STREAM_LOOP_END
+
+   CARE_STREAM_LOOP(i, 0, len2) {
+      array2[i] = -1.5 * i;
+   } CARE_STREAM_LOOP_END
+
+   ReductionFuser<double, RAJADeviceExec> fuser;
+   fuser.fusibleReduceArray(array1, len1, reduction_op::max);
+   fuser.fusibleReduceArray(array2, len2, reduction_op::min);
+   fuser.fusibleReduceArray(array2, len2, reduction_op::sum);
+
+   double results[3];
+   fuser.reduce(results);
+
+   EXPECT_EQ(results[0], 16.0);
+   EXPECT_EQ(results[1], -13.5);
+   EXPECT_EQ(results[2], -67.5);
+
+   array2.free();
+   array1.free();
+}
+
+#endif // CARE_GPUCC
@@ -147,3 +147,228 @@ GPU_TEST(Scan, test_scan_offset_index_gid) {
 }
 
 #endif
+
+// Long enough for the host scans to use threads in OpenMP builds
+static const int scanTestSize = 300001;
+
+CARE_HOST_DEVICE static int scanTestValue(const int i)
+{
+   return (i % 13) * 7919 % 13 - 6;
+}
+
+TEST(scan, exclusive)
+{
+   const int n = scanTestSize;
+   care::host_device_ptr<int> in(n, "in");
+   care::host_device_ptr<int> out(n, "out");
+
+   for (int pass = 0; pass < 4; ++pass) {
+      const bool parallel = pass & 1;
+      const bool inPlace = pass & 2;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         in[i] = scanTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (parallel) {
+         care::exclusive_scan(RAJAExec{}, in, out, n, 5, inPlace);
+      }
+      else {
+         care::exclusive_scan(RAJA::seq_exec{}, in, out, n, 5, inPlace);
+      }
+
+      care::host_device_ptr<int> result = inPlace ? in : out;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+         int sum = 5;
+
+         for (int j = 0; j < n; ++j) {
+            EXPECT_EQ(result[j], sum);
+            sum += scanTestValue(j);
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   out.free();
+   in.free();
+}
+
+TEST(scan, inclusive)
+{
+   const int n = scanTestSize;
+   care::host_device_ptr<double> in(n, "in");
+   care::host_device_ptr<double> out(n, "out");
+
+   for (int pass = 0; pass < 4; ++pass) {
+      const bool parallel = pass & 1;
+      const bool inPlace = pass & 2;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         in[i] = scanTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (parallel) {
+         care::inclusive_scan(RAJAExec{}, in, out, n, inPlace);
+      }
+      else {
+         care::inclusive_scan(RAJA::seq_exec{}, in, out, n, inPlace);
+      }
+
+      care::host_device_ptr<double> result = inPlace ? in : out;
+
+      // Small integers are summed exactly in any order
+      CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+         double sum = 0.0;
+
+         for (int j = 0; j < n; ++j) {
+            sum += scanTestValue(j);
+            EXPECT_EQ(result[j], sum);
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   out.free();
+   in.free();
+}
+
+// Segments start every scanTestSegment elements
+static const int scanTestSegment = 997;
+
+TEST(scan, segmented)
+{
+   const int n = scanTestSize;
+   const int numSegments = (n + scanTestSegment - 1) / scanTestSegment;
+   care::host_device_ptr<int> in(n, "in");
+   care::host_device_ptr<int> out(n, "out");
+   care::host_device_ptr<bool> headFlags(n, "headFlags");
+   care::host_device_ptr<int> offsets(numSegments, "offsets");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, n) {
+      headFlags[i] = i % scanTestSegment == 0;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   CARE_SEQUENTIAL_LOOP(s, 0, numSegments) {
+      offsets[s] = s * scanTestSegment;
+   } CARE_SEQUENTIAL_LOOP_END
+
+   for (int pass = 0; pass < 16; ++pass) {
+      const bool parallel = pass & 1;
+      const bool inPlace = pass & 2;
+      const bool inclusive = pass & 4;
+      const bool useOffsets = pass & 8;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         in[i] = scanTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (parallel) {
+         if (inclusive) {
+            if (useOffsets) {
+               care::segmented_inclusive_scan(RAJAExec{}, in, out, n, offsets, numSegments, inPlace);
+            }
+            else {
+               care::segmented_inclusive_scan(RAJAExec{}, in, out, n, headFlags, inPlace);
+            }
+         }
+         else {
+            if (useOffsets) {
+               care::segmented_exclusive_scan(RAJAExec{}, in, out, n, offsets, numSegments, 5, inPlace);
+            }
+            else {
+               care::segmented_exclusive_scan(RAJAExec{}, in, out, n, headFlags, 5, inPlace);
+            }
+         }
+      }
+      else {
+         if (inclusive) {
+            if (useOffsets) {
+               care::segmented_inclusive_scan(RAJA::seq_exec{}, in, out, n, offsets, numSegments, inPlace);
+            }
+            else {
+               care::segmented_inclusive_scan(RAJA::seq_exec{}, in, out, n, headFlags, inPlace);
+            }
+         }
+         else {
+            if (useOffsets) {
+               care::segmented_exclusive_scan(RAJA::seq_exec{}, in, out, n, offsets, numSegments, 5, inPlace);
+            }
+            else {
+               care::segmented_exclusive_scan(RAJA::seq_exec{}, in, out, n, headFlags, 5, inPlace);
+            }
+         }
+      }
+
+      care::host_device_ptr<int> result = inPlace ? in : out;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, 1) {
+         int sum = 0;
+
+         for (int j = 0; j < n; ++j) {
+            if (j % scanTestSegment == 0) {
+               sum = inclusive ? 0 : 5;
+            }
+
+            if (inclusive) {
+               sum += scanTestValue(j);
+               EXPECT_EQ(result[j], sum);
+            }
+            else {
+               EXPECT_EQ(result[j], sum);
+               sum += scanTestValue(j);
+            }
+         }
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   offsets.free();
+   headFlags.free();
+   out.free();
+   in.free();
+}
+
+TEST(scan, total)
+{
+   const int n = scanTestSize;
+   care::host_device_ptr<int> in(n, "in");
+   care::host_device_ptr<int> out(n, "out");
+   chai::ManagedArray<int> total(1, CARE_SCANVARLENGTHNAME_SPACE);
+
+   int expectedTotal = 5;
+
+   for (int j = 0; j < n; ++j) {
+      expectedTotal += scanTestValue(j);
+   }
+
+   for (int pass = 0; pass < 4; ++pass) {
+      const bool parallel = pass & 1;
+      const bool inPlace = pass & 2;
+
+      CARE_SEQUENTIAL_LOOP(i, 0, n) {
+         in[i] = scanTestValue(i);
+      } CARE_SEQUENTIAL_LOOP_END
+
+      if (parallel) {
+         care::exclusive_scan(RAJAExec{}, in, out, n, 5, inPlace, total);
+      }
+      else {
+         care::exclusive_scan(RAJA::seq_exec{}, in, out, n, 5, inPlace, total);
+      }
+
+      int scanTotal = 0;
+      care::getFinalScanCountFromPinned(total, scanTotal);
+      EXPECT_EQ(scanTotal, expectedTotal);
+
+      care::host_device_ptr<int> result = inPlace ? in : out;
+      EXPECT_EQ(result.pick(n - 1) + scanTestValue(n - 1), expectedTotal);
+   }
+
+   // The total of an empty scan is the starting value
+   int scanTotal = 0;
+   care::exclusive_scan(RAJAExec{}, in, out, 0, 7, false, total);
+   care::getFinalScanCountFromPinned(total, scanTotal);
+   EXPECT_EQ(scanTotal, 7);
+
+   total.free();
+   out.free();
+   in.free();
+}
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// Copyright 2020 Lawrence Livermore National Security, LLC and other CARE developers.
+// See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "care/config.h"
+
+// other library headers
+#include "gtest/gtest.h"
+
+// care headers
+#include "care/algorithm.h"
+#include "care/SortedIndex.h"
+#include "care/detail/test_utils.h"
+
+#if defined(CARE_GPUCC)
+GPU_TEST(forall, Initialization) {
+   printf("Initializing\n");
+   init_care_for_testing();
+   printf("Initialized... Testing care::SortedIndex\n");
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// @brief Test case that checks that SortedIndex agrees with BinarySearch
+///        for every value in and around the range of a sorted array with
+///        duplicates, for every length up to the size of the array.
+///
+/////////////////////////////////////////////////////////////////////////
+TEST(SortedIndex, MatchesBinarySearch)
+{
+   const int size = 12;
+   int data[size] = {-4, 0, 1, 1, 1, 3, 6, 6, 10, 11, 11, 20};
+   care::host_device_ptr<int> sorted(size, "sorted");
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size) {
+      sorted[i] = data[i];
+   } CARE_SEQUENTIAL_LOOP_END
+
+   for (int length = 0; length <= size; ++length) {
+      care::SortedIndex<int> index(sorted, length);
+      EXPECT_EQ(index.size(), length);
+
+      CARE_SEQUENTIAL_LOOP(num, -6, 23) {
+         const int lower = index.search(num);
+         const int expected = care::BinarySearch<int>(data, 0, length, num, false);
+
+         if (expected == -1) {
+            EXPECT_EQ(lower, -1);
+         }
+         else {
+            // BinarySearch may return any of the duplicates
+            ASSERT_GE(lower, 0);
+            EXPECT_EQ(data[lower], num);
+            EXPECT_TRUE(lower == 0 || data[lower - 1] < num);
+         }
+
+         EXPECT_EQ(index.search(num, true),
+                   care::BinarySearch<int>(data, 0, length, num, true));
+      } CARE_SEQUENTIAL_LOOP_END
+   }
+
+   sorted.free();
+}
+
+#if defined(CARE_GPUCC)
+
+GPU_TEST(SortedIndex, MatchesBinarySearch)
+{
+   const int size = 12;
+   care::host_device_ptr<int> sorted(size, "sorted");
+   care::host_device_ptr<int> results(2 * size, "results");
+
+   CARE_GPU_KERNEL {
+      sorted[0] = -4;
+      sorted[1] = 0;
+      sorted[2] = 1;
+      sorted[3] = 1;
+      sorted[4] = 1;
+      sorted[5] = 3;
+      sorted[6] = 6;
+      sorted[7] = 6;
+      sorted[8] = 10;
+      sorted[9] = 11;
+      sorted[10] = 11;
+      sorted[11] = 20;
+   } CARE_GPU_KERNEL_END
+
+   care::SortedIndex<int> index(sorted, size);
+
+   CARE_STREAM_LOOP(i, 0, size) {
+      results[2 * i] = index.search(sorted[i]);
+      results[2 * i + 1] = index.search(sorted[i], true);
+   } CARE_STREAM_LOOP_END
+
+   CARE_SEQUENTIAL_LOOP(i, 0, size) {
+      const int lower = results[2 * i];
+      const int upper = results[2 * i + 1];
+
+      ASSERT_GE(lower, 0);
+      EXPECT_EQ(sorted[lower], sorted[i]);
+      EXPECT_EQ(upper, care::BinarySearch<int>(sorted, 0, size, sorted[i], true));
+   } CARE_SEQUENTIAL_LOOP_END
+
+   results.free();
+   sorted.free();
+}
+
+#endif // CARE_GPUCC